@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace MorphFixer {
+
+    // Allocator for RaceMenu's ChangeWeight request slot (arg0). RaceMenu numbers its own calls
+    // and we interleave drives with them, so both sides share one monotonic sequence:
+    //  - reserve(n) hands out [base, base+n) with a single fetch_add; no two reservations overlap.
+    //  - observe(v) advances the high-water mark past a native slot, so later reservations
+    //    start after anything RaceMenu has already used.
+    // A native slot that lands on one of our recent reservations is a collision: RaceMenu and a
+    // drive raced for the same slot. Those are counted (recent = last WINDOW reserved slots).
+    // Lock-free; callable from any thread.
+    class Arg0Sequence {
+    public:
+        static constexpr std::size_t WINDOW = 64;
+
+        struct Stats {
+            std::uint64_t reserved{0};    // slots handed out
+            std::uint64_t observed{0};    // native slots seen
+            std::uint64_t collisions{0};  // native slot equal to a recent reservation
+            std::int64_t next{0};         // next slot reserve() would return
+        };
+
+        Arg0Sequence() noexcept;
+
+        // First slot of a fresh [base, base+count) range.
+        [[nodiscard]] std::int64_t reserve(std::uint32_t count = 1) noexcept;
+
+        // Feed a native arg0. Non-finite / negative values are ignored. Returns true on collision.
+        bool observe(double arg0) noexcept;
+
+        // New menu session: zero the counters only. The sequence itself never goes back. Nothing
+        // shows RaceMenu restarts its numbering with the movie, and a slot handed out twice is
+        // exactly the collision this class exists to prevent. If RaceMenu does restart at 0, its
+        // slots stay below ours and observe() keeps the two apart.
+        void resetStats() noexcept;
+
+        [[nodiscard]] Stats stats() const noexcept;
+
+    private:
+        std::atomic<std::int64_t> m_next{0};
+        std::array<std::atomic<std::int64_t>, WINDOW> m_recent{};  // slot % WINDOW -> slot (-1 = none)
+
+        std::atomic<std::uint64_t> m_reserved{0};
+        std::atomic<std::uint64_t> m_observed{0};
+        std::atomic<std::uint64_t> m_collisions{0};
+    };
+
+}  // namespace MorphFixer
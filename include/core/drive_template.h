@@ -0,0 +1,154 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "core/seqlock.h"
+
+namespace MorphFixer {
+
+    // Fixed-capacity copy of one ChangeWeight argument. Strings are kept inline (truncated), so
+    // recording never allocates and the whole snapshot can be copied with a plain memcpy. Anything
+    // that isn't a number, bool or string is replayed as undefined.
+    struct ArgCopy {
+        static constexpr std::size_t INLINE_CHARS = 48;
+
+        enum class Kind : std::uint8_t { kUndefined, kNumber, kBoolean, kString };
+
+        Kind t{Kind::kUndefined};
+        double num{0.0};
+        bool b{false};
+        std::array<char, INLINE_CHARS> s{};  // NUL-terminated
+
+        // Value: RE::GFxValue, or a stand-in with the same setters (tools/drive_bench)
+        template <class Value>
+        void toValue(Value& out) const {
+            switch (t) {
+                case Kind::kNumber:
+                    out.SetNumber(num);
+                    break;
+                case Kind::kBoolean:
+                    out.SetBoolean(b);
+                    break;
+                case Kind::kString:
+                    out.SetString(s.data());  // points into this copy: keep it alive for the call
+                    break;
+                default:
+                    out.SetUndefined();
+                    break;
+            }
+        }
+
+        template <class Value>
+        static ArgCopy from(const Value& v) {
+            ArgCopy c;
+            if (v.IsNumber()) {
+                c.t = Kind::kNumber;
+                c.num = v.GetNumber();
+            } else if (v.IsBool()) {
+                c.t = Kind::kBoolean;
+                c.b = v.GetBool();
+            } else if (v.IsString()) {
+                c.t = Kind::kString;
+                const char* str = v.GetString();
+                const auto n = str ? strnlen(str, INLINE_CHARS - 1) : 0;
+                if (n) std::memcpy(c.s.data(), str, n);
+                c.s[n] = '\0';
+            }
+            return c;
+        }
+    };
+
+    struct ArgSnapshot {
+        static constexpr std::uint32_t MAX_ARGS = 8;  // RaceMenu's ChangeWeight sends 3
+
+        std::uint32_t argc{0};
+        std::array<ArgCopy, MAX_ARGS> args{};  // arg[1] is normalized weight
+    };
+    static_assert(std::is_trivially_copyable_v<ArgSnapshot>);
+
+    // Everything about a ChangeWeight call except the two values we patch (arg0, arg1):
+    // argc, every arg type, and the values of args 2+. 0 means "no snapshot yet".
+    inline std::uint64_t shapeOf(const ArgSnapshot& snap) noexcept {
+        std::uint64_t h = 1469598103934665603ull;
+        const auto mix = [&h](const void* p, std::size_t n) {
+            const auto* b = static_cast<const unsigned char*>(p);
+            for (std::size_t i = 0; i < n; ++i) h = (h ^ b[i]) * 1099511628211ull;
+        };
+        mix(&snap.argc, sizeof(snap.argc));
+        for (std::uint32_t i = 0; i < snap.argc; ++i) {
+            const auto& a = snap.args[i];
+            mix(&a.t, sizeof(a.t));
+            if (i < 2) continue;
+            mix(&a.num, sizeof(a.num));
+            mix(&a.b, sizeof(a.b));
+            mix(a.s.data(), strnlen(a.s.data(), a.s.size()));
+        }
+        return h ? h : 1;
+    }
+
+    // The last real ChangeWeight(args), behind a Seqlock: RaceMenu's callbacks write it,
+    // weight lookups and our own drives copy it out. Nobody blocks, nothing allocates.
+    class ArgSnapshotCell {
+    public:
+        template <class Value>
+        void store(const Value* args, std::uint32_t argc) noexcept {
+            m_cell.write([&](ArgSnapshot& d) {
+                d.argc = std::min(argc, ArgSnapshot::MAX_ARGS);
+                for (std::uint32_t i = 0; i < d.argc; ++i) d.args[i] = ArgCopy::from(args[i]);
+                m_shape.store(shapeOf(d), std::memory_order_relaxed);
+            });
+        }
+
+        // false until the first store()
+        bool load(ArgSnapshot& out) const noexcept { return m_cell.load(out); }
+
+        // Cheap change detector for cached call templates (see DriveTemplate)
+        [[nodiscard]] std::uint64_t shape() const noexcept { return m_shape.load(std::memory_order_acquire); }
+
+    private:
+        Seqlock<ArgSnapshot> m_cell;
+        std::atomic<std::uint64_t> m_shape{0};
+    };
+
+    // Prepared ChangeWeight arguments for our drives, built from RaceMenu's last real call and
+    // reused until that call's shape changes (or the menu session ends). A drive only patches
+    // arg0/arg1 in place. UI thread only: drives run from UI tasks.
+    template <class Value>
+    struct DriveTemplate {
+        std::uint64_t shape{0};  // 0 = stale
+        ArgSnapshot source{};    // owns the inline strings args[] point at
+        std::array<Value, ArgSnapshot::MAX_ARGS> args;
+        std::uint32_t argc{0};
+        std::uint64_t rebuilds{0};
+
+        void invalidate() noexcept { shape = 0; }
+
+        void rebuild(const ArgSnapshotCell& cell) {
+            ++rebuilds;
+            shape = cell.shape();
+            argc = 3;
+            if (cell.load(source) && source.argc > 1) {
+                argc = source.argc;
+                for (std::uint32_t i = 0; i < argc; ++i) source.args[i].toValue(args[i]);
+            } else {
+                shape = 0;  // defaults: rebuild once RaceMenu sends a real ChangeWeight
+                args[0].SetNumber(0.0);
+                args[1].SetNumber(0.0);
+                args[2].SetNumber(2.0);
+            }
+        }
+
+        std::uint32_t prepare(const ArgSnapshotCell& cell, double arg0, double normalized) {
+            if (shape == 0 || shape != cell.shape()) rebuild(cell);
+            args[0].SetNumber(arg0);
+            args[1].SetNumber(std::clamp(normalized, 0.0, 1.0));
+            return argc;
+        }
+    };
+
+}  // namespace MorphFixer
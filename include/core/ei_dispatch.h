@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "core/ei_event_names.h"
+
+namespace RE {
+    class GFxValue;
+}
+
+namespace MorphFixer {
+
+    // One ExternalInterface call, decoded once by the proxy and shared by every observer:
+    // name resolved to id/class, and the leading numeric args unpacked from their GFxValues.
+    struct EiEvent {
+        static constexpr std::uint32_t MAX_NUMERIC = 4;
+
+        const char* name{nullptr};
+        Helpers::EventNames::EventId id{Helpers::EventNames::NO_EVENT};
+        Helpers::EventClassifier::EventClass cls{Helpers::EventClassifier::EventClass::kUnknown};
+        std::uint32_t argc{0};
+        const RE::GFxValue* args{nullptr};  // raw, for observers that need strings (snapshot)
+        std::uint32_t numericMask{0};       // bit i: args[i] is a number (i < MAX_NUMERIC)
+        std::array<double, MAX_NUMERIC> num{};
+
+        [[nodiscard]] std::optional<double> number(std::uint32_t i) const noexcept {
+            if (i >= MAX_NUMERIC || !((numericMask >> i) & 1)) return std::nullopt;
+            return num[i];
+        }
+
+        // Defined in ei_event.cpp, the only part that needs GFxValue
+        static EiEvent decode(const char* name, const RE::GFxValue* args, std::uint32_t argc) noexcept;
+    };
+
+    // Observers of the routed (RaceMenu) movie's EI calls, indexed by event class. The table is
+    // filled once at startup; a callback then costs one decode plus a walk over the observers
+    // subscribed to that class, with no name matching per observer (tools/dispatch_bench).
+    class EiDispatch {
+    public:
+        enum class Phase : std::uint8_t {
+            kBeforeOriginal,  // before RaceMenu handles the call
+            kAfterOriginal,   // after it (RaceMenu state already updated)
+        };
+        using Observer = void (*)(const EiEvent&);
+        using ClassMask = std::uint32_t;
+
+        static constexpr std::size_t MAX_OBSERVERS = 8;  // per class and phase
+
+        static constexpr ClassMask maskOf(Helpers::EventClassifier::EventClass c) noexcept {
+            return ClassMask{1} << static_cast<unsigned>(c);
+        }
+        static constexpr ClassMask ALL_CLASSES = (ClassMask{1} << Helpers::EventClassifier::EVENT_CLASS_COUNT) - 1;
+
+        static EiDispatch& get();
+        EiDispatch(const EiDispatch&) = delete;
+        EiDispatch& operator=(const EiDispatch&) = delete;
+
+        // Startup only, before any movie is proxied. False when a class row is full.
+        bool subscribe(Phase phase, ClassMask classes, Observer fn) noexcept;
+
+        void dispatch(Phase phase, const EiEvent& ev) const noexcept {
+            const auto& row = m_rows[static_cast<std::size_t>(phase)][static_cast<std::size_t>(ev.cls)];
+            for (std::uint8_t i = 0; i < row.count; ++i) row.fns[i](ev);
+        }
+
+    private:
+        EiDispatch() = default;
+
+        struct Row {
+            std::uint8_t count{0};
+            std::array<Observer, MAX_OBSERVERS> fns{};
+        };
+        std::array<std::array<Row, Helpers::EventClassifier::EVENT_CLASS_COUNT>, 2> m_rows{};
+    };
+
+}  // namespace MorphFixer
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include "helpers/ascii.h"
+
+namespace MorphFixer {
+    namespace Helpers::EventClassifier {
+
+        enum class EventClass : std::uint8_t {
+            kUnknown,  // not a RaceMenu name we route
+            kWeight,   // ChangeWeight: carries the live weight, never a refresh trigger
+            kSlider,   // Change* slider-ish events that need a morph refresh
+            kPreset,        // preset-related: arms the preset cooldown
+            kPresetChange,  // preset applied through a Change* call: cooldown, and needs a refresh
+            kIgnored,       // Change* events that are not slider changes (race, sex, menu)
+        };
+        inline constexpr std::size_t EVENT_CLASS_COUNT = static_cast<std::size_t>(EventClass::kIgnored) + 1;
+
+        struct Entry {
+            std::string_view name;
+            EventClass cls;
+        };
+
+        // Known RaceMenu ExternalInterface vocabulary. Matching is ASCII case-insensitive.
+        inline constexpr Entry VOCABULARY[] = {
+            {"ChangeWeight", EventClass::kWeight},
+            {"ChangeHeadPart", EventClass::kSlider},
+            {"ChangeTintingMask", EventClass::kSlider},
+            {"ChangeMaskColor", EventClass::kSlider},
+            {"ChangeDoubleMorph", EventClass::kSlider},
+            {"ChangePreset", EventClass::kPresetChange},
+            {"ChangeHairColorPreset", EventClass::kPresetChange},
+            {"LoadPreset", EventClass::kPreset},
+            {"SavePreset", EventClass::kPreset},
+            {"ChangeRace", EventClass::kIgnored},
+            {"ChangeSex", EventClass::kIgnored},
+            {"ChangeMenuOpen", EventClass::kIgnored},
+            {"ChangeMenuClose", EventClass::kIgnored},
+        };
+        inline constexpr std::size_t VOCABULARY_SIZE = std::size(VOCABULARY);
+
+        using Ascii::equalsIgnoreCase;
+
+        // Either preset class: arms the preset cooldown.
+        constexpr bool isPreset(EventClass c) noexcept {
+            return c == EventClass::kPreset || c == EventClass::kPresetChange;
+        }
+
+        // Index into VOCABULARY, or -1. A linear scan: with 13 short names, most rejected on length,
+        // it beats a perfect hash, which has to fold and hash every byte (tools/event_names_check).
+        constexpr int vocabularyIndex(std::string_view name) noexcept {
+            for (std::size_t i = 0; i < VOCABULARY_SIZE; ++i) {
+                if (equalsIgnoreCase(VOCABULARY[i].name, name)) return static_cast<int>(i);
+            }
+            return -1;
+        }
+
+        constexpr EventClass classifyKnown(std::string_view name) noexcept {
+            const auto i = vocabularyIndex(name);
+            return i >= 0 ? VOCABULARY[i].cls : EventClass::kUnknown;
+        }
+
+        // Names outside the vocabulary: the old substring rules ("Change" anywhere, exact case, is a
+        // slider; anything mentioning "preset" in any case is a preset, a preset change if it also
+        // says "Change"). Slow path; callers cache the result per interned name.
+        EventClass classifyFallback(std::string_view name) noexcept;
+
+        static_assert(classifyKnown("ChangeWeight") == EventClass::kWeight);
+        static_assert(classifyKnown("changeweight") == EventClass::kWeight);
+        static_assert(classifyKnown("ChangeWeightX") == EventClass::kUnknown);
+        static_assert(classifyKnown("ChangePreset") == EventClass::kPresetChange);
+        static_assert(classifyKnown("LoadPreset") == EventClass::kPreset);
+
+    }  // namespace Helpers::EventClassifier
+}  // namespace MorphFixer
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include "core/ei_event_classifier.h"
+
+namespace MorphFixer {
+    namespace Helpers::EventNames {
+
+        // Small integer handle for an ExternalInterface callback name. 0 means "none".
+        // Ids 1..VOCABULARY_SIZE are the compile-time RaceMenu vocabulary (EventClassifier);
+        // everything else is interned at runtime on first sight.
+        using EventId = std::uint16_t;
+        inline constexpr EventId NO_EVENT = 0;
+
+        struct EventInfo {
+            EventId id{NO_EVENT};
+            EventClassifier::EventClass cls{EventClassifier::EventClass::kUnknown};
+        };
+
+        // Known names: a scan of the vocabulary. Unknown names: lock-free insert/lookup in a fixed
+        // table (no allocation), classified once with the fallback rules and cached.
+        // Returns NO_EVENT / kUnknown for empty names or when the table is full.
+        EventInfo resolve(std::string_view name) noexcept;
+
+        inline EventId intern(std::string_view name) noexcept { return resolve(name).id; }
+
+        EventClassifier::EventClass classOf(EventId id) noexcept;
+
+        // For logs. Names longer than the inline buffer come back truncated.
+        std::string_view nameOf(EventId id) noexcept;
+
+    }  // namespace Helpers::EventNames
+}  // namespace MorphFixer
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+#include "core/ei_session.h"
+
+namespace MorphFixer {
+
+    // Proxied movies, keyed by movie pointer. Fixed slots; each slot's proxy is created on first
+    // use and then reused for every later menu session, so open/close does not allocate after
+    // warm-up. The registry keeps one reference per proxy for the life of the process; the movie
+    // holds its own while the proxy is installed. install/remove run on the main thread (menu
+    // events); lookup only reads atomics and is safe from any thread.
+    //
+    // Traits supplies the game types and the two state-bag calls, so the AddRef/Release pairing
+    // can be checked host-side against counting fakes (tools/ei_session_check):
+    //   using Movie, EI, Proxy;                    Proxy derives from EI
+    //   static EI* stateAddRef(Movie*);            current EI, add-ref'd for the caller
+    //   static void setState(Movie*, EI*);         movie takes its own reference
+    // Proxy needs bind(Ref, bool route), unbind(), original(), isRouted() and setRoute(bool).
+    template <class Traits, std::size_t N = 8>
+    class EiProxyRegistry {
+    public:
+        using Movie = typename Traits::Movie;
+        using EI = typename Traits::EI;
+        using Proxy = typename Traits::Proxy;
+        using Ref = BasicExternalInterfaceRef<EI>;
+
+        static constexpr std::size_t MAX_MOVIES = N;
+
+        struct Slot {
+            std::atomic<Movie*> movie{nullptr};
+            Proxy* proxy{nullptr};
+        };
+
+        enum class Install { kInstalled, kAlreadyInstalled, kRerouted, kNoInterface, kFull };
+
+        [[nodiscard]] Slot* lookup(Movie* mv) noexcept {
+            if (!mv) return nullptr;
+            for (auto& s : m_slots) {
+                if (s.movie.load(std::memory_order_acquire) == mv) return &s;
+            }
+            return nullptr;
+        }
+
+        // Wrap mv's EI with a pooled proxy (which keeps the reference taken here). A routed movie
+        // is also pinned in session so drives reach the proxy without another state lookup.
+        // Installing again on a proxied movie only updates its route (and the session pin).
+        template <class Session>
+        Install install(Movie* mv, bool route, Session& session) {
+            if (!mv) return Install::kNoInterface;
+
+            auto* ei = Traits::stateAddRef(mv);
+            if (auto* slot = lookup(mv)) {
+                if (ei && ei == slot->proxy) {
+                    ei->Release();
+                    return reroute(*slot, mv, route, session) ? Install::kRerouted : Install::kAlreadyInstalled;
+                }
+                // Our proxy is not this movie's EI: the movie we proxied was destroyed without a
+                // remove() and a new one got its address. Its state bag is gone, so there is
+                // nothing to restore; drop our hold on its original and reuse the slot.
+                evict(*slot, mv, session);
+            }
+            if (!ei) return Install::kNoInterface;
+
+            auto* slot = claim(mv);
+            if (!slot) {
+                ei->Release();
+                return Install::kFull;
+            }
+
+            auto* proxy = slot->proxy;
+            proxy->bind(Ref::adopt(ei), route);
+            Traits::setState(mv, proxy);
+            if (route) session.open(mv, Ref::retain(proxy));
+            return Install::kInstalled;
+        }
+
+        // Restore mv's original EI, unpin it if it owns session, and free the slot. Returns the
+        // proxy (counters still readable until its next bind) or nullptr if mv was not proxied.
+        template <class Session>
+        Proxy* remove(Movie* mv, Session& session) {
+            auto* slot = lookup(mv);
+            if (!slot) return nullptr;
+            auto* proxy = slot->proxy;
+
+            Traits::setState(mv, proxy->original());
+            evict(*slot, mv, session);
+            return proxy;
+        }
+
+        // Proxies created so far (one per slot ever used)
+        [[nodiscard]] std::size_t proxies() const noexcept {
+            std::size_t n = 0;
+            for (const auto& s : m_slots) n += s.proxy != nullptr;
+            return n;
+        }
+
+    private:
+        // False when the proxy already had that route.
+        template <class Session>
+        bool reroute(Slot& slot, Movie* mv, bool route, Session& session) {
+            if (slot.proxy->isRouted() == route) return false;
+            slot.proxy->setRoute(route);
+            if (route) {
+                session.open(mv, Ref::retain(slot.proxy));
+            } else if (session.lookup(mv)) {
+                session.close();
+            }
+            return true;
+        }
+
+        // Unpin mv if it owns session, release the proxy's original and free the slot.
+        template <class Session>
+        void evict(Slot& slot, Movie* mv, Session& session) {
+            if (session.lookup(mv)) session.close();
+            slot.proxy->unbind();
+            slot.movie.store(nullptr, std::memory_order_release);
+        }
+
+        // A free slot for mv (proxy created on the slot's first use), or nullptr when full.
+        [[nodiscard]] Slot* claim(Movie* mv) {
+            for (auto& s : m_slots) {
+                if (s.movie.load(std::memory_order_relaxed)) continue;
+                if (!s.proxy) s.proxy = new Proxy();
+                s.movie.store(mv, std::memory_order_release);
+                return &s;
+            }
+            return nullptr;
+        }
+
+        std::array<Slot, N> m_slots{};
+    };
+
+}  // namespace MorphFixer
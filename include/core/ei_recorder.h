@@ -0,0 +1,67 @@
+#pragma once
+#include "pch.h"
+
+#include "core/ei_trace_format.h"
+
+namespace MorphFixer {
+
+    // Flight recorder for ExternalInterface traffic. The proxy appends one fixed-size record per
+    // callback into a lock-free ring (oldest records are overwritten); nothing is formatted or
+    // written while RaceMenu is open. On close the session is dumped as a binary *.rmft file
+    // that tools/ei_trace prints and tools/cadence_replay replays.
+    class EiRecorder {
+    public:
+        using Record = Helpers::EiTrace::Record;
+
+        static constexpr std::size_t CAPACITY = 16384;  // power of two; ~800 KB
+
+        static EiRecorder& get();
+        EiRecorder(const EiRecorder&) = delete;
+        EiRecorder& operator=(const EiRecorder&) = delete;
+
+        void setEnabled(bool e) noexcept { m_enabled.store(e, std::memory_order_relaxed); }
+        [[nodiscard]] bool enabled() const noexcept { return m_enabled.load(std::memory_order_relaxed); }
+
+        // Any thread. Origin comes from the calling thread's DriverScope.
+        void record(const char* name, const RE::GFxValue* args, std::uint32_t argc) noexcept;
+
+        // Marks EI calls made by our own ChangeWeight driver on this thread.
+        class DriverScope {
+        public:
+            DriverScope() noexcept;
+            ~DriverScope();
+            DriverScope(const DriverScope&) = delete;
+            DriverScope& operator=(const DriverScope&) = delete;
+
+            // True while this thread is inside a DriverScope (the EI call is one of ours).
+            [[nodiscard]] static bool active() noexcept;
+
+        private:
+            bool m_prev;
+        };
+
+        // Start a fresh session (menu open).
+        void clear() noexcept;
+
+        // Write the current session to <SKSE log dir>/<plugin>/ei_<unix seconds>.rmft and clear it.
+        // Returns false when disabled, empty, or the file could not be written.
+        bool dumpSession();
+
+    private:
+        struct Slot {
+            std::atomic<std::uint64_t> seq{0};  // index + 1 once published, 0 while being written
+            Record rec;
+        };
+
+        EiRecorder() = default;
+
+        // Copy out the published records in order; returns how many were overwritten.
+        std::uint64_t snapshot(std::vector<Record>& out) const;
+
+        std::atomic<bool> m_enabled{false};
+        alignas(64) std::atomic<std::uint64_t> m_head{0};
+        std::atomic<std::uint64_t> m_start{0};  // first index of the current session
+        std::unique_ptr<Slot[]> m_slots{std::make_unique<Slot[]>(CAPACITY)};
+    };
+
+}  // namespace MorphFixer
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+namespace RE {
+    class GFxExternalInterface;
+    class GFxMovieView;
+}
+
+namespace MorphFixer {
+
+    // Owning reference to an ExternalInterface: one Release() when it goes away. EI is anything
+    // with AddRef()/Release() (GFx ref counting; tools/ei_session_check uses a counting fake).
+    template <class EI>
+    class BasicExternalInterfaceRef {
+    public:
+        BasicExternalInterfaceRef() = default;
+        ~BasicExternalInterfaceRef() { reset(); }
+
+        // Take over a reference the caller already holds (GetStateAddRef, new).
+        static BasicExternalInterfaceRef adopt(EI* ei) noexcept { return BasicExternalInterfaceRef(ei); }
+        // Add a reference of our own.
+        static BasicExternalInterfaceRef retain(EI* ei) noexcept {
+            if (ei) ei->AddRef();
+            return BasicExternalInterfaceRef(ei);
+        }
+
+        BasicExternalInterfaceRef(BasicExternalInterfaceRef&& o) noexcept : m_ei(std::exchange(o.m_ei, nullptr)) {}
+        BasicExternalInterfaceRef& operator=(BasicExternalInterfaceRef&& o) noexcept {
+            if (this != &o) {
+                reset();
+                m_ei = std::exchange(o.m_ei, nullptr);
+            }
+            return *this;
+        }
+        BasicExternalInterfaceRef(const BasicExternalInterfaceRef&) = delete;
+        BasicExternalInterfaceRef& operator=(const BasicExternalInterfaceRef&) = delete;
+
+        void reset() noexcept {
+            if (auto* ei = std::exchange(m_ei, nullptr)) ei->Release();
+        }
+
+        [[nodiscard]] EI* get() const noexcept { return m_ei; }
+        explicit operator bool() const noexcept { return m_ei != nullptr; }
+
+    private:
+        explicit BasicExternalInterfaceRef(EI* ei) noexcept : m_ei(ei) {}
+
+        EI* m_ei{nullptr};
+    };
+
+    // One movie's ExternalInterface (our proxy once installed), pinned for one menu session:
+    // resolved once on open, released on close. Drives look it up instead of paying a state-bag
+    // lookup and an AddRef/Release pair per ChangeWeight.
+    //
+    // Threading: open/close come from the menu open/close event and drives from UI tasks, both on
+    // the main thread, so a pointer returned by lookup() stays valid for the caller's drive. The
+    // generation tells callers that cached a session apart from a newer one.
+    template <class Movie, class EI>
+    class BasicEiSession {
+    public:
+        using Ref = BasicExternalInterfaceRef<EI>;
+
+        BasicEiSession() = default;
+        BasicEiSession(const BasicEiSession&) = delete;
+        BasicEiSession& operator=(const BasicEiSession&) = delete;
+
+        // Closes any open session first. Returns the new generation, or 0 when nothing was pinned.
+        std::uint32_t open(Movie* mv, Ref ei) noexcept {
+            if (m_generation.load(std::memory_order_relaxed) & 1) close();
+            if (!mv || !ei) return 0;
+
+            m_pinned.store(ei.get(), std::memory_order_relaxed);
+            m_ref = std::move(ei);
+            m_movie.store(mv, std::memory_order_relaxed);
+            return m_generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+        }
+
+        // Returns the new generation, or 0 when no session was open.
+        std::uint32_t close() noexcept {
+            if (!(m_generation.load(std::memory_order_relaxed) & 1)) return 0;
+
+            const auto gen = m_generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+            m_movie.store(nullptr, std::memory_order_relaxed);
+            m_pinned.store(nullptr, std::memory_order_relaxed);
+            m_ref.reset();
+            return gen;
+        }
+
+        // Pinned EI for mv, or nullptr when no session is open on that movie. Not add-ref'd.
+        [[nodiscard]] EI* lookup(Movie* mv) const noexcept {
+            const auto gen = m_generation.load(std::memory_order_acquire);
+            if (!(gen & 1) || !mv || m_movie.load(std::memory_order_relaxed) != mv) return nullptr;
+            auto* ei = m_pinned.load(std::memory_order_relaxed);
+            return m_generation.load(std::memory_order_acquire) == gen ? ei : nullptr;
+        }
+
+        // Pinned EI for mv; outside a session, one taken with stateAddRef(mv) and held by fallback
+        // until the caller is done with it.
+        template <class StateAddRef>
+        [[nodiscard]] EI* lookupOr(Movie* mv, Ref& fallback, StateAddRef&& stateAddRef) const noexcept {
+            if (auto* ei = lookup(mv)) return ei;
+            if (!mv) return nullptr;
+            fallback = Ref::adopt(stateAddRef(mv));
+            return fallback.get();
+        }
+
+        // Bumped on every open and close; odd while a session is open.
+        [[nodiscard]] std::uint32_t generation() const noexcept { return m_generation.load(std::memory_order_acquire); }
+
+    private:
+        std::atomic<Movie*> m_movie{nullptr};
+        std::atomic<EI*> m_pinned{nullptr};
+        Ref m_ref;
+        std::atomic<std::uint32_t> m_generation{0};
+    };
+
+    using ExternalInterfaceRef = BasicExternalInterfaceRef<RE::GFxExternalInterface>;
+
+    // The RaceMenu movie's session. open/close log the pin and release.
+    class EiSession : public BasicEiSession<RE::GFxMovieView, RE::GFxExternalInterface> {
+    public:
+        static EiSession& get();
+
+        std::uint32_t open(RE::GFxMovieView* mv, ExternalInterfaceRef ei) noexcept;
+        std::uint32_t close() noexcept;
+
+    private:
+        EiSession() = default;
+    };
+
+}  // namespace MorphFixer
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace MorphFixer {
+    namespace Helpers::EiTrace {
+
+        // On-disk format of recorded ExternalInterface traffic (*.rmft). Everything is little-endian
+        // and written field by field, so the reader does not depend on the writer's struct layout.
+        //
+        //   header   magic "RMFT", u16 version, u16 max args, u32 name count, u32 record count,
+        //            u64 records lost to ring overwrite, i64 steady-clock ns of the first record
+        //   names    name count x { u16 id, u8 length, bytes }   (ids are only stable per file)
+        //   records  record count x { i64 ns since first record, u16 id, u8 argc, u8 origin,
+        //                             MAX_ARGS x u8 type, MAX_ARGS x f64 value }
+        inline constexpr std::array<char, 4> MAGIC{'R', 'M', 'F', 'T'};
+        inline constexpr std::uint16_t VERSION = 1;
+        inline constexpr std::size_t MAX_ARGS = 4;  // ChangeWeight and the slider callbacks use <= 3
+
+        enum class ArgType : std::uint8_t {
+            kUndefined,
+            kNull,
+            kBool,
+            kNumber,
+            kString,  // payload not kept
+            kOther,   // objects, arrays, wide strings
+        };
+
+        enum class Origin : std::uint8_t {
+            kRaceMenu,  // Scaleform called out to RaceMenu
+            kDriver,    // our own ChangeWeight drive passing through the proxy
+        };
+
+        struct Record {
+            long long t_ns{0};
+            std::uint16_t id{0};
+            std::uint8_t argc{0};  // real argc, may exceed MAX_ARGS
+            Origin origin{Origin::kRaceMenu};
+            std::array<ArgType, MAX_ARGS> types{};
+            std::array<double, MAX_ARGS> values{};  // numbers as-is, bools as 0/1
+        };
+
+        struct Name {
+            std::uint16_t id{0};
+            std::string name;
+        };
+
+        struct Trace {
+            std::uint64_t lost{0};  // overwritten before the dump
+            long long base_ns{0};
+            std::vector<Name> names;
+            std::vector<Record> records;  // t_ns relative to base_ns
+
+            [[nodiscard]] std::string_view nameOf(std::uint16_t id) const noexcept;
+        };
+
+        bool write(std::ostream& out, const Trace& trace);
+        bool read(std::istream& in, Trace& out, std::string* error = nullptr);
+
+    }  // namespace Helpers::EiTrace
+}  // namespace MorphFixer
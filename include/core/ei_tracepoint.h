@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+// Deferred EI proxy tracepoints. Built with RMF_ENABLE_EI_TRACE (Debug builds, or the CMake option
+// of the same name); otherwise RMF_EI_TRACE expands to nothing and its arguments are never evaluated.
+//
+// A tracepoint copies raw values (the name, argc, first numeric args) into a buffer owned
+// by the calling thread and returns; the TimerWheel thread drains all buffers a little later and
+// hands them to the writer (the "[gfx-ei]" log line), so the UI thread never waits on the log file.
+#if RMF_ENABLE_EI_TRACE
+    #define RMF_EI_TRACE(name, args, argc) ::MorphFixer::EiTracepoints::emit((name), (args), (argc))
+#else
+    #define RMF_EI_TRACE(name, args, argc) ((void)0)
+#endif
+
+namespace MorphFixer {
+    namespace EiTracepoints {
+
+        inline constexpr std::uint32_t NUM_ARGS = 3;
+        inline constexpr std::size_t NAME_CHARS = 40;  // longer names are traced truncated
+
+        // The name is copied, not interned: observed menus bring names of their own, and those
+        // must not take EventNames slots the routed movie needs.
+        struct Entry {
+            long long t_ns;
+            std::array<char, NAME_CHARS> name;
+            std::uint8_t name_len;
+            std::uint8_t argc;
+            std::uint8_t numeric;  // bit i: args[i] was a number
+            std::array<double, NUM_ARGS> num;
+        };
+
+        // Where drained entries go; both run on the draining thread. The plugin logs them
+        // (gfx_ei_hook.cpp), tools/tracepoint_bench counts them. Unset: entries are discarded.
+        struct Writer {
+            void (*entry)(const Entry& e, long long nowNs){nullptr};
+            void (*lost)(std::uint64_t dropped){nullptr};  // entries that found their ring full
+        };
+
+#if RMF_ENABLE_EI_TRACE
+        void setWriter(Writer w) noexcept;
+
+        // Any thread, lock-free: one slot in this thread's ring. Full ring -> counted and dropped.
+        void record(const char* name, std::uint32_t argc, const std::array<double, NUM_ARGS>& num,
+                    std::uint8_t numeric) noexcept;
+
+        // Value: RE::GFxValue, or a stand-in with IsNumber/GetNumber (tools/tracepoint_bench)
+        template <class Value>
+        void emit(const char* name, const Value* args, std::uint32_t argc) noexcept {
+            if (!name) return;
+            std::array<double, NUM_ARGS> num{};
+            std::uint8_t numeric = 0;
+            for (std::uint32_t i = 0; args && i < NUM_ARGS && i < argc; ++i) {
+                if (!args[i].IsNumber()) continue;
+                num[i] = args[i].GetNumber();
+                numeric |= static_cast<std::uint8_t>(1u << i);
+            }
+            record(name, argc, num, numeric);
+        }
+
+        // Hand everything buffered so far to the writer. Runs on the timer thread; also called on
+        // menu close so the last calls of a session are not left in the rings.
+        void drain();
+#else
+        inline void drain() {}
+#endif
+
+    }
+}  // namespace MorphFixer
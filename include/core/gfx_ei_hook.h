@@ -4,12 +4,17 @@
 namespace MorphFixer {
     namespace Hooks::GfxExternalInterface {
 
-        // Install a proxy ExternalInterface on this movie.
-        // Safe to call multiple times; it will no-op if already installed.
-        bool enable(RE::GFxMovieView* mv);
+        // Install a proxy ExternalInterface on this movie. Several movies can be proxied at once:
+        // RaceMenu is routed (recorded, decoded and fed to the EiDispatch observers), the menus in
+        // [debug] observe_menus are only counted and traced, then forwarded.
+        // Safe to call multiple times; on a proxied movie it only updates the route.
+        bool enable(RE::GFxMovieView* mv, bool routeToMorphUpdater = false);
 
-        // Restore original EI (if this hook installed one).
+        // Restore original EI (if this hook installed one). Other proxied movies are unaffected.
         void disable(RE::GFxMovieView* mv);
 
+        // Per-movie counters since enable: all EI calls, and those routed to EiDispatch.
+        bool callStats(RE::GFxMovieView* mv, std::uint64_t& calls, std::uint64_t& routed);
+
     }  // namespace hooks::gfx_ei
 }  // namespace MorphFixer
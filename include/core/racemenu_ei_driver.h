@@ -1,11 +1,14 @@
 #pragma once
+#include "core/arg0_sequence.h"
 #include "pch.h"
 
 namespace MorphFixer {
+    struct EiEvent;
+
     namespace Helpers::RaceMenuExternalInterface {
 
-        // Feed every ExternalInterface call from EI proxy.
-        void observe(const char* name, const RE::GFxValue* args, std::uint32_t argc);
+        // EiDispatch observer for every class, before RaceMenu handles the call.
+        void observe(const EiEvent& ev);
 
         // True while a preset operation is in-flight / just finished.
         bool presetCooldownActive();
@@ -16,17 +19,22 @@ namespace MorphFixer {
         // Get last seen normalized weight [0..1] from snapshot if we have one.
         bool snapshotLastWeight(double& outNorm);
 
-        // Drive ChangeWeight with normalized [0..1] via EI (arg0 auto-managed).
+        // Drive ChangeWeight with normalized [0..1] via EI (arg0 reserved from the shared sequence).
         bool driveChangeWeightNorm(RE::GFxMovieView* mv, double normalized);
 
         // --- New overloads for precise arg0 control -----------------------------
         // Drive ChangeWeight with normalized value and an explicit arg0.
         bool driveChangeWeightNormWithArg0(RE::GFxMovieView* mv, double normalized, double arg0);
 
-        // Nudge then restore around 'normalized', using two sequential arg0s.
-        // We "fence" one slot (base = nextArg0()+1) to avoid collisions with the
-        // next native EI call in the same frame.
+        // Nudge then restore around 'normalized', using two consecutive arg0s reserved as one range.
         bool nudgeThenRestoreNorm(RE::GFxMovieView* mv, double normalized, double epsilon = 0.01);
 
+        // New menu session: drop the cached ChangeWeight argument template and zero the arg0 counters
+        // (the arg0 sequence itself stays monotonic across sessions).
+        void resetSession();
+
+        // arg0 allocator counters (reservations, native slots seen, collisions).
+        Arg0Sequence::Stats arg0Stats();
+
     }  // namespace helpers::racemenu_ei
 }
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace MorphFixer {
+
+    // Single-cell seqlock for a small trivially copyable value. Odd sequence = write in progress.
+    // Writers take the odd slot with a CAS (so several writer threads are fine) and fill the value
+    // in place; readers memcpy it out and retry if the sequence moved meanwhile. Nobody blocks on
+    // a reader, nothing allocates. Readers spin while a write is in flight, so keep writes short.
+    template <class T>
+    class Seqlock {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+    public:
+        // fn(T&) fills the value; runs with the sequence odd.
+        template <class Fn>
+        void write(Fn&& fn) noexcept {
+            auto seq = m_seq.load(std::memory_order_relaxed);
+            while ((seq & 1) || !m_seq.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire)) {
+                seq = m_seq.load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_release);
+            fn(m_data);
+            m_seq.store(seq + 2, std::memory_order_release);
+        }
+
+        void store(const T& value) noexcept {
+            write([&value](T& d) { std::memcpy(&d, &value, sizeof(T)); });
+        }
+
+        // false until the first write
+        bool load(T& out) const noexcept {
+            while (true) {
+                const auto s1 = m_seq.load(std::memory_order_acquire);
+                if (s1 == 0) return false;
+                if (s1 & 1) continue;
+                std::memcpy(&out, &m_data, sizeof(T));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (m_seq.load(std::memory_order_relaxed) == s1) return true;
+            }
+        }
+
+        // Completed writes so far (for stats and tests)
+        [[nodiscard]] std::uint32_t writes() const noexcept { return m_seq.load(std::memory_order_relaxed) >> 1; }
+
+    private:
+        std::atomic<std::uint32_t> m_seq{0};
+        T m_data{};
+    };
+
+}  // namespace MorphFixer
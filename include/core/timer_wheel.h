@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace MorphFixer {
+
+    // One shared service for every delayed action in the plugin (tail flush, preset cooldown,
+    // cache polling, trace drain). Hierarchical wheel, 1 ms ticks, 3 levels x 64 slots (~262 s range).
+    // Arm / re-arm / cancel are O(1); the worker thread sleeps until the next occupied slot
+    // and does not wake at all while nothing is armed.
+    class TimerWheel {
+    public:
+        using TimerId = std::uint32_t;
+        using Callback = std::function<void()>;
+
+        static constexpr TimerId INVALID_TIMER = 0xFFFFFFFFu;
+        static constexpr std::size_t MAX_TIMERS = 256;
+
+        static TimerWheel& get();
+        TimerWheel(const TimerWheel&) = delete;
+        TimerWheel& operator=(const TimerWheel&) = delete;
+
+        // Register a timer once (setup time). The callback runs on the wheel thread, outside
+        // the wheel lock, so it may re-arm itself. Returns INVALID_TIMER when the pool is full.
+        TimerId create(Callback cb);
+
+        // Arm or re-arm. An armed timer is moved, never duplicated.
+        void arm(TimerId id, std::chrono::nanoseconds delay) noexcept;
+        void armAt(TimerId id, long long dueNs) noexcept;  // steady_clock ns, same base as now_ns()
+
+        void cancel(TimerId id) noexcept;
+        [[nodiscard]] bool armed(TimerId id) const noexcept;
+
+        // Stop the worker (plugin unload). Returns once it has left its loop, without joining:
+        // the unload path runs under the loader lock, which a thread needs in order to exit.
+        // Safe to call more than once; nothing fires afterwards.
+        void shutdown() noexcept;
+
+        // Times the worker woke up (deadline, re-arm or stop), for tools/tail_flush_bench
+        [[nodiscard]] std::uint64_t wakeups() const noexcept { return m_wakeups.load(std::memory_order_relaxed); }
+
+        static long long nowNs() noexcept;
+
+    private:
+        static constexpr int SLOT_BITS = 6;
+        static constexpr int SLOTS = 1 << SLOT_BITS;
+        static constexpr int LEVELS = 3;
+        static constexpr std::int32_t NIL = -1;
+        static constexpr std::chrono::milliseconds SHUTDOWN_WAIT{500};  // a callback still running
+
+        struct Node {
+            Callback cb;
+            long long due_tick{0};
+            std::int32_t prev{NIL};
+            std::int32_t next{NIL};
+            std::int32_t slot{NIL};  // level * SLOTS + index, NIL when idle
+        };
+
+        TimerWheel();
+        // No lock, no join: at process exit Windows has already killed the worker, possibly while
+        // it held m_mutex. shutdown() is the teardown path.
+        ~TimerWheel() {
+            if (m_thread.joinable()) m_thread.detach();
+        }
+
+        // Deadlines round up, the current time rounds down: a timer never fires before its due time.
+        [[nodiscard]] long long tickOf(long long ns) const noexcept;
+        [[nodiscard]] long long elapsedTick(long long ns) const noexcept;
+        [[nodiscard]] long long nsOf(long long tick) const noexcept;
+
+        void link(std::int32_t id) noexcept;
+        void unlink(std::int32_t id) noexcept;
+        void cascade(int level, long long tick) noexcept;
+        [[nodiscard]] long long nextTick() const noexcept;
+        void advanceTo(long long tick) noexcept;
+
+        void ensureThread() noexcept;
+        void run() noexcept;
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::thread m_thread;
+        bool m_stop{false};
+        bool m_running{false};  // the worker is inside run()
+        std::atomic<std::uint64_t> m_wakeups{0};
+        long long m_wake_tick{-1};  // what the worker is currently sleeping towards (-1 = idle)
+
+        const long long m_epoch_ns;
+        long long m_now_tick{0};  // last processed tick
+
+        std::vector<Node> m_nodes;  // capacity fixed at MAX_TIMERS; never reallocates
+        std::array<std::int32_t, LEVELS * SLOTS> m_heads{};
+        std::array<std::uint64_t, LEVELS> m_occupied{};
+        std::vector<std::int32_t> m_fire;  // scratch for expired ids, reused
+    };
+
+}  // namespace MorphFixer
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace MorphFixer {
+
+    enum class UiOp : std::uint8_t {
+        kSlider,  // coalesced slider refresh (nudge or restore)
+        kTail,    // idle tail flush (restore / balanced nudge+restore)
+        kSettle,  // a refresh's mesh update has run: closes its adaptive cadence sample
+    };
+
+    // Trivially-copyable work record handed to the UI thread (no closures, no heap).
+    struct UiCommand {
+        UiOp op{UiOp::kSlider};
+        bool flag{false};          // kTail: previous drive was a nudge
+        std::uint16_t eventId{0};  // Helpers::EventNames id (logging / latest-wins)
+        double baseline{-1.0};     // session baseline in [0,1]; <0 means "read it when run"
+        long long postedNs{0};     // clock ns at submit (kSettle: of the command that drove)
+        long long driveNs{0};      // kSettle: clock ns when the drive started
+    };
+    static_assert(std::is_trivially_copyable_v<UiCommand>);
+
+}  // namespace MorphFixer
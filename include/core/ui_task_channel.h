@@ -0,0 +1,88 @@
+#pragma once
+#include "pch.h"
+
+#include "core/ui_command.h"
+
+namespace MorphFixer {
+
+    // Fixed-capacity, allocation-free path from the EI callback / timer wheel into SKSE's UI task
+    // queue. Producers push trivially-copyable command records into a bounded ring; a single
+    // static UIDelegate ("pump") is queued at most once at a time and drains the ring on the UI
+    // thread. No closures, no std::function, no per-command heap traffic on our side.
+    class UiTaskChannel {
+    public:
+        using Op = UiOp;
+        using Command = UiCommand;
+
+        using Handler = void (*)(const Command&) noexcept;
+
+        static constexpr std::size_t CAPACITY = 64;  // power of two
+
+        // Allocation counts are this plugin's operator new calls on the submitting / UI thread
+        // (Helpers::Alloc); both stay at 0 in steady state when the path is allocation-free, and
+        // always in builds that do not count (Helpers::Alloc::COUNTING).
+        struct Stats {
+            std::uint64_t submitted{0};
+            std::uint64_t dropped{0};        // ring full
+            std::uint64_t pumps{0};          // UIDelegate submissions to SKSE
+            std::uint64_t inline_drains{0};  // no task interface: drained on the submitting thread
+            std::uint64_t executed{0};
+            std::uint64_t submit_allocs{0};   // inside submit(), excluding inline drains
+            std::uint64_t handler_allocs{0};  // inside the handler, per drained command
+        };
+
+        static UiTaskChannel& get();
+        UiTaskChannel(const UiTaskChannel&) = delete;
+        UiTaskChannel& operator=(const UiTaskChannel&) = delete;
+
+        void setHandler(Handler h) noexcept { m_handler.store(h, std::memory_order_release); }
+
+        // Multi-producer, lock-free. Returns false (and counts a drop) when the ring is full.
+        bool submit(const Command& cmd) noexcept;
+
+        // Commands queued and not yet drained (approximate while producers race).
+        [[nodiscard]] std::size_t depth() const noexcept {
+            const auto head = m_head.load(std::memory_order_relaxed);
+            const auto tail = m_tail.load(std::memory_order_relaxed);
+            return head > tail ? head - tail : 0;
+        }
+
+        [[nodiscard]] Stats stats() const noexcept;
+        void resetStats() noexcept;
+
+    private:
+        struct Pump final : SKSE::UIDelegate_v1 {
+            void Run() override { UiTaskChannel::get().drain(); }
+            void Dispose() override {}  // static storage, reused
+        };
+
+        struct Cell {
+            std::atomic<std::size_t> seq{0};
+            Command cmd;
+        };
+
+        UiTaskChannel();
+
+        bool push(const Command& cmd) noexcept;
+        bool pop(Command& out) noexcept;
+        bool schedulePump() noexcept;
+        void drain() noexcept;
+
+        std::array<Cell, CAPACITY> m_cells;
+        alignas(64) std::atomic<std::size_t> m_head{0};  // producers
+        alignas(64) std::atomic<std::size_t> m_tail{0};  // consumer (UI thread)
+
+        Pump m_pump;
+        std::atomic<bool> m_pump_queued{false};
+        std::atomic<Handler> m_handler{nullptr};
+
+        std::atomic<std::uint64_t> m_submitted{0};
+        std::atomic<std::uint64_t> m_dropped{0};
+        std::atomic<std::uint64_t> m_pumps{0};
+        std::atomic<std::uint64_t> m_inline_drains{0};
+        std::atomic<std::uint64_t> m_executed{0};
+        std::atomic<std::uint64_t> m_submit_allocs{0};
+        std::atomic<std::uint64_t> m_handler_allocs{0};
+    };
+
+}  // namespace MorphFixer
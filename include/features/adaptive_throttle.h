@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace MorphFixer {
+
+    // Closed-loop cadence tuning. Every refresh reports how long it took from the drive to the end
+    // of the mesh update it queued (cost) and from the event being queued to that point
+    // (completion). CadenceEngine closes each sample with a follow-up task that runs once the
+    // model update has (kSettle). The smoothed completion time then sets the slider throttle and
+    // the idle gap before the tail flush, each clamped to the configured bounds, which sit on both
+    // sides of the fixed values: a cheap refresh speeds the cadence up, an expensive one slows it.
+    //
+    // Samples are reported from the game's main thread, one at a time; the chosen values and
+    // summary() are read from any thread.
+    class AdaptiveThrottle {
+    public:
+        struct Config {
+            bool enabled{true};
+            int throttle_ms{100};  // start value, and the fixed value when disabled
+            int throttle_min_ms{50};
+            int throttle_max_ms{400};
+            int idle_gap_ms{150};
+            int idle_gap_min_ms{75};
+            int idle_gap_max_ms{600};
+        };
+
+        struct Summary {
+            int throttle_ms{0};
+            int idle_gap_ms{0};
+            std::uint64_t samples{0};
+            double avg_cost_ms{0.0};
+            double avg_completion_ms{0.0};
+        };
+
+        void configure(const Config& cfg) noexcept;
+
+        // costNs: drive start -> its mesh update has run; completionNs: event queued -> same point
+        void onDriveCompleted(long long costNs, long long completionNs) noexcept;
+
+        [[nodiscard]] int throttleMs() const noexcept { return m_throttle_ms.load(std::memory_order_relaxed); }
+        [[nodiscard]] int idleGapMs() const noexcept { return m_idle_gap_ms.load(std::memory_order_relaxed); }
+        [[nodiscard]] Summary summary() const noexcept;
+
+    private:
+        // Multipliers on the completion time: the throttle lets one refresh settle before the next
+        // drive, the idle gap gives a drag's last throttled event time to arrive before the tail.
+        static constexpr double THROTTLE_FACTOR = 2.0;
+        static constexpr double IDLE_GAP_FACTOR = 3.0;
+        static constexpr double EWMA_ALPHA = 0.125;
+
+        Config m_cfg{};
+        // EWMAs: one writer at a time (settle tasks), atomic so summary() can read them from anywhere
+        std::atomic<double> m_cost_ns{0.0};
+        std::atomic<double> m_completion_ns{0.0};
+        std::atomic<std::uint64_t> m_samples{0};
+
+        std::atomic<int> m_throttle_ms{100};
+        std::atomic<int> m_idle_gap_ms{150};
+    };
+
+}  // namespace MorphFixer
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "core/ei_event_names.h"
+#include "core/ui_command.h"
+#include "features/adaptive_throttle.h"
+#include "helpers/histogram.h"
+
+namespace MorphFixer {
+
+    // The nudge / restore / tail session state machine, free of Scaleform, SKSE and threads.
+    // Time, task submission, the tail timer and the weight being driven are all injected, so
+    // the same code runs in the game (MorphUpdater) and under virtual time (tools/cadence_replay).
+    //
+    // Threading (game): onEvent() from the EI callback, onTailTimer() from the timer wheel,
+    // runTask() on the UI thread (kSettle: the main-thread task pass). All shared state is atomic.
+    class CadenceEngine {
+    public:
+        struct Clock {
+            virtual ~Clock() = default;
+            [[nodiscard]] virtual long long nowNs() const noexcept = 0;
+        };
+
+        struct TaskSink {
+            virtual ~TaskSink() = default;
+            // Queue cmd for runTask() on the UI thread. false = dropped.
+            virtual bool submit(const UiCommand& cmd) noexcept = 0;
+            // Queue a kSettle cmd for runTask() behind the work the drive just queued (SKEE's model
+            // update), so it runs once the mesh is rebuilt. false = dropped, the sample is lost.
+            virtual bool submitSettle(const UiCommand& cmd) noexcept = 0;
+            // Call onTailTimer() once the clock reaches dueNs (re-arming moves the deadline).
+            virtual void armTail(long long dueNs) noexcept = 0;
+            virtual void cancelTail() noexcept = 0;
+            // Commands submitted but not yet run (queue depth sampling).
+            [[nodiscard]] virtual std::size_t depth() const noexcept = 0;
+        };
+
+        struct WeightSource {
+            virtual ~WeightSource() = default;
+            // Live normalized weight [0,1] when no session baseline is known.
+            [[nodiscard]] virtual double currentNorm() noexcept = 0;
+        };
+
+        struct WeightDriver {
+            virtual ~WeightDriver() = default;
+            // RaceMenu is open and can be driven; checked once per task.
+            [[nodiscard]] virtual bool ready() noexcept = 0;
+            virtual bool drive(double norm) noexcept = 0;
+            virtual bool nudgeRestore(double norm, double epsilon) noexcept = 0;
+
+            // Direct morph re-apply (SKEE), one mesh update and no weight change.
+            [[nodiscard]] virtual bool canRefresh() noexcept = 0;
+            virtual bool refresh() noexcept = 0;
+
+            // Morphs differ from the last set we refreshed for; a true answer is taken as "about to
+            // be applied" (the driver remembers it). Drivers that can't tell return true.
+            [[nodiscard]] virtual bool morphsChanged() noexcept = 0;
+        };
+
+        enum class RefreshMode : std::uint8_t {
+            kNudge,  // drive RaceMenu's ChangeWeight -/+1% and back (two mesh rebuilds per refresh)
+            kSkee,   // re-apply morphs through SKEE; falls back to kNudge when SKEE is unavailable
+        };
+
+        enum class EventResult : std::uint8_t {
+            kDisabled,
+            kIgnored,    // not a refresh trigger
+            kBaseline,   // ChangeWeight seen (baseline primed when no session)
+            kPosted,     // queued a UI task
+            kMerged,     // folded into the already-queued UI task
+            kThrottled,  // inside the throttle window; the tail covers it
+        };
+
+        struct Stats {
+            std::uint64_t received{0};   // eligible Change* events seen
+            std::uint64_t throttled{0};  // dropped by the throttle window (tail covers them)
+            std::uint64_t merged{0};     // folded into an already-queued UI task
+            std::uint64_t executed{0};   // slider tasks that actually drove ChangeWeight
+            std::uint64_t drives{0};     // ChangeWeight drives issued (nudge+restore counts 2)
+            std::uint64_t refreshes{0};  // direct SKEE refreshes
+            std::uint64_t tails{0};      // tail flushes executed
+            std::uint64_t sessions{0};   // update sessions started
+            std::uint64_t skipped{0};    // refreshes skipped: morphs unchanged since the last one
+        };
+
+        // Latency distributions, ns unless noted. Recorded lock-free on the hot paths.
+        struct Latency {
+            Helpers::LogLinearHistogram eventToTask;     // slider event posted -> UI task runs
+            Helpers::LogLinearHistogram taskToDrive;     // UI task start -> ChangeWeight drive returned
+            Helpers::LogLinearHistogram driveToSettle;   // drive start -> the mesh update it queued has run
+            Helpers::LogLinearHistogram nudgeToRestore;  // nudge drive -> the restore that undoes it
+            Helpers::LogLinearHistogram tailDelay;       // tail deadline -> tail timer actually ran
+            Helpers::LogLinearHistogram queueDepth;      // commands queued after each submit (count)
+        };
+
+        static constexpr double NUDGE_EPSILON = 0.01;
+        static constexpr int MAX_UI_TASKS = 1;  // per-frame coalescing bound
+
+        CadenceEngine(const Clock& clock, TaskSink& sink, WeightSource& weights, WeightDriver& driver) noexcept
+            : m_clock(clock), m_sink(sink), m_weights(weights), m_driver(driver) {}
+
+        CadenceEngine(const CadenceEngine&) = delete;
+        CadenceEngine& operator=(const CadenceEngine&) = delete;
+
+        void configure(const AdaptiveThrottle::Config& cfg) noexcept { m_cadence.configure(cfg); }
+        [[nodiscard]] const AdaptiveThrottle& cadence() const noexcept { return m_cadence; }
+
+        void setRefreshMode(RefreshMode m) noexcept { m_mode.store(m, std::memory_order_relaxed); }
+        [[nodiscard]] RefreshMode refreshMode() const noexcept { return m_mode.load(std::memory_order_relaxed); }
+
+        // Ask the driver before each refresh and skip it when no morph changed.
+        void setSkipUnchanged(bool on) noexcept { m_skip_unchanged.store(on, std::memory_order_relaxed); }
+
+        void setEnabled(bool e) noexcept { m_enabled.store(e, std::memory_order_relaxed); }
+        [[nodiscard]] bool enabled() const noexcept { return m_enabled.load(std::memory_order_relaxed); }
+
+        // One EI callback. weightNorm is ChangeWeight's arg1 when numeric.
+        EventResult onEvent(std::string_view name, std::optional<double> weightNorm) noexcept;
+        // Same, with the name already resolved and classified (EiDispatch decodes it once per callback).
+        EventResult onEvent(Helpers::EventNames::EventInfo ev, std::optional<double> weightNorm) noexcept;
+
+        // Tail deadline reached (TaskSink::armTail).
+        void onTailTimer() noexcept;
+
+        // Execute a submitted command (UI thread).
+        void runTask(const UiCommand& cmd) noexcept;
+
+        // Menu closed: end the session, drop pending work. Stats are kept until resetStats().
+        void reset() noexcept;
+
+        [[nodiscard]] Stats stats() const noexcept;
+        [[nodiscard]] const Latency& latency() const noexcept { return m_latency; }
+        void resetStats() noexcept;  // counters and latency histograms
+
+        [[nodiscard]] bool sessionActive() const noexcept { return m_session_active.load(std::memory_order_relaxed); }
+        [[nodiscard]] double baselineNorm() const noexcept { return m_baseline_norm.load(std::memory_order_relaxed); }
+        [[nodiscard]] long long tailDueNs() const noexcept { return m_tail_due_ns.load(std::memory_order_relaxed); }
+
+    private:
+        // baseline outside [0,1] means "use the session baseline / live weight"
+        [[nodiscard]] double resolveBaseline(double hint) noexcept;
+        void applyNudge(double baseline) noexcept;
+        void applyRestore(double baseline) noexcept;
+        void applyNudgeRestore(double baseline) noexcept;
+        void applyRefresh() noexcept;
+        [[nodiscard]] bool useSkee() noexcept;
+        // skip_unchanged on and the driver reports the applied morphs are current (counted)
+        [[nodiscard]] bool morphsUnchanged() noexcept;
+
+        void runSlider(const UiCommand& cmd) noexcept;
+        void runTail(const UiCommand& cmd) noexcept;
+        void runSettle(const UiCommand& cmd) noexcept;
+        // Close the cadence sample of a drive that started at driveNs once its mesh update has run
+        void settle(long long driveNs, long long postedNs) noexcept;
+        void armTail(long long dueNs) noexcept;
+        bool submit(const UiCommand& cmd) noexcept;
+
+        const Clock& m_clock;
+        TaskSink& m_sink;
+        WeightSource& m_weights;
+        WeightDriver& m_driver;
+
+        std::atomic<bool> m_enabled{false};
+        AdaptiveThrottle m_cadence;  // throttle + tail idle gap; config bounds, tuned per settled refresh
+        std::atomic<RefreshMode> m_mode{RefreshMode::kNudge};
+        std::atomic<bool> m_skip_unchanged{false};
+
+        std::atomic<std::uint16_t> m_last_event_id{0};  // Helpers::EventNames id of the last applied event
+        std::atomic<long long> m_last_applied_ns{-1};
+        std::atomic<long long> m_tail_due_ns{-1};
+        std::atomic<bool> m_last_was_nudge{false};
+        std::atomic<bool> m_dirty{false};  // an eligible event has not been refreshed yet (SKEE mode)
+        long long m_nudge_ns{-1};  // UI thread only: when the outstanding nudge was driven
+
+        // Baseline weight captured for the CURRENT SESSION (in [0,1]; <0 means unset)
+        std::atomic<double> m_baseline_norm{-1.0};
+        std::atomic<bool> m_session_active{false};
+
+        // Per-frame coalescing: latest eligible event wins
+        std::atomic<std::uint16_t> m_pending_event_id{0};
+        std::atomic<int> m_ui_tasks_outstanding{0};
+
+        std::atomic<std::uint64_t> m_received{0};
+        std::atomic<std::uint64_t> m_throttled{0};
+        std::atomic<std::uint64_t> m_merged{0};
+        std::atomic<std::uint64_t> m_executed{0};
+        std::atomic<std::uint64_t> m_drives{0};
+        std::atomic<std::uint64_t> m_refreshes{0};
+        std::atomic<std::uint64_t> m_tails{0};
+        std::atomic<std::uint64_t> m_sessions{0};
+        std::atomic<std::uint64_t> m_skipped{0};
+
+        Latency m_latency;
+    };
+
+}  // namespace MorphFixer
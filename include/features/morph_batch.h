@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "helpers/string_pool.h"
+
+namespace RE {
+    class TESObjectREFR;
+}
+namespace SKEE {
+    class IBodyMorphInterface;
+}
+
+namespace MorphFixer {
+
+    // Collects SetMorph / ClearMorph operations for any number of actors and pushes them to SKEE
+    // in one pass: per actor, ops sorted by (morph name, key) with only the last op per key kept,
+    // then exactly one deferred ApplyBodyMorphs and one UpdateModelWeight. Per-key calls no longer
+    // each pay for a model update (preset application, enforcement).
+    //
+    // Names and keys are interned into the batch's own pool; the pool is kept across apply() so a
+    // batch reused for the same morph set stops allocating. Main thread only (SKEE calls).
+    class MorphBatch {
+    public:
+        struct Result {
+            std::uint32_t actors{0};      // actors updated (one apply + one model update each)
+            std::uint32_t sets{0};        // SetMorph calls issued
+            std::uint32_t clears{0};      // ClearMorph calls issued
+            std::uint32_t superseded{0};  // ops dropped because a later op hit the same key
+        };
+
+        MorphBatch& set(RE::TESObjectREFR* actor, std::string_view name, std::string_view key, float value);
+        MorphBatch& clear(RE::TESObjectREFR* actor, std::string_view name, std::string_view key);
+
+        // Apply everything queued, then empty the batch. An empty batch touches nothing. Nothing is
+        // logged here (the class builds host-side too); callers log the Result.
+        Result apply(SKEE::IBodyMorphInterface& bmi);
+
+        void reset() noexcept { m_ops.clear(); }
+        [[nodiscard]] std::size_t size() const noexcept { return m_ops.size(); }
+        [[nodiscard]] bool empty() const noexcept { return m_ops.empty(); }
+
+    private:
+        struct Op {
+            RE::TESObjectREFR* actor;
+            Helpers::StringPool::Id name;
+            Helpers::StringPool::Id key;
+            std::uint32_t seq;  // queue order: the later op on a key wins
+            float value;
+            bool clear;
+        };
+
+        void push(RE::TESObjectREFR* actor, std::string_view name, std::string_view key, float value, bool clear);
+
+        Helpers::StringPool m_strings;
+        std::vector<Op> m_ops;
+    };
+
+}  // namespace MorphFixer
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+
+#include "core/seqlock.h"
+#include "core/timer_wheel.h"
+#include "features/morph_cache_policy.h"
+
+namespace SKEE {
+    class IBodyMorphInterface;
+}
+
+namespace MorphFixer {
+
+    // Keeps SKEE's body morph cache sized to the process's memory use. A timer-wheel poll samples
+    // private commit and, when the policy's limit moves, posts SetCacheLimit to the main thread.
+    // Safe points (RaceMenu closed, a save loaded) clear the cache once memory is above low water.
+    class MorphCache {
+    public:
+        static MorphCache& get();
+        MorphCache(const MorphCache&) = delete;
+        MorphCache& operator=(const MorphCache&) = delete;
+
+        void setMorphInterface(SKEE::IBodyMorphInterface* bmi) noexcept { m_bmi.store(bmi); }
+        // Apply settings and (re)start the poll; disabled stops it and leaves SKEE's limit alone.
+        void configure(const MorphCachePolicy::Config& cfg);
+
+        // Main thread only: no morph application may be in flight.
+        void onSafePoint(std::string_view reason) noexcept;
+
+    private:
+        MorphCache() = default;
+
+        void poll() noexcept;  // wheel thread
+
+        // Written by configure() (main thread), copied out by poll() on the wheel thread
+        Seqlock<MorphCachePolicy> m_policy;
+        std::atomic<SKEE::IBodyMorphInterface*> m_bmi{nullptr};
+        std::atomic<bool> m_enabled{false};
+        std::atomic<std::uint64_t> m_limit{0};  // last limit handed to SKEE (0 = never set)
+        TimerWheel::TimerId m_timer{TimerWheel::INVALID_TIMER};
+    };
+
+}  // namespace MorphFixer
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+
+namespace MorphFixer {
+
+    // Sizing rule for SKEE's body morph (vertex diff) cache from process memory use. Below the
+    // low-water mark the cache may use its full budget; between low and high water the limit
+    // shrinks linearly to the minimum; at or above high water it stays at the minimum. Safe points
+    // (menu close, after a load) clear the cache once usage has reached low water.
+    //
+    // Pure arithmetic on a snapshot of the config; callers supply the memory readings.
+    class MorphCachePolicy {
+    public:
+        struct Config {
+            bool enabled{false};
+            int limit_min_mb{128};
+            int limit_max_mb{1024};
+            int low_water_mb{6144};
+            int high_water_mb{10240};
+            int poll_ms{10000};
+        };
+
+        enum class Pressure : std::uint8_t {
+            kLow,       // below low water
+            kElevated,  // between the marks
+            kHigh,      // at or above high water
+        };
+
+        // Limits move in steps of this size so jitter in the reading doesn't reach SKEE
+        static constexpr std::uint64_t LIMIT_STEP_BYTES = 16ull << 20;
+
+        void configure(const Config& cfg) noexcept;  // bounds are sorted and clamped
+        [[nodiscard]] const Config& config() const noexcept { return m_cfg; }
+
+        [[nodiscard]] Pressure pressureFor(std::uint64_t processBytes) const noexcept;
+        // Cache limit in bytes for this reading, rounded down to LIMIT_STEP_BYTES.
+        [[nodiscard]] std::uint64_t limitFor(std::uint64_t processBytes) const noexcept;
+        [[nodiscard]] bool clearAtSafePoint(std::uint64_t processBytes) const noexcept {
+            return m_cfg.enabled && pressureFor(processBytes) != Pressure::kLow;
+        }
+
+    private:
+        Config m_cfg{};
+    };
+
+}  // namespace MorphFixer
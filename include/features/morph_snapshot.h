@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "helpers/string_pool.h"
+
+namespace MorphFixer {
+
+    // Dense ids for body morph names and keys ("Breasts", "RSMPlugin"). Ids are stable for the
+    // process, so snapshots compare by integer. Main thread only.
+    using MorphStringIds = Helpers::StringPool;
+
+    // One actor's body morphs as parallel columns (name id, key id, value), sorted by (name, key)
+    // so two snapshots compare with a linear scan. Buffers are reused across captures.
+    class MorphSnapshot {
+    public:
+        using Id = MorphStringIds::Id;
+
+        void clear() noexcept;
+        void add(Id name, Id key, float value);
+        // Sort rows into (name, key) order; call once after the last add().
+        void finish();
+
+        [[nodiscard]] std::size_t size() const noexcept { return m_values.size(); }
+        [[nodiscard]] std::span<const Id> names() const noexcept { return m_names; }
+        [[nodiscard]] std::span<const Id> keys() const noexcept { return m_keys; }
+        [[nodiscard]] std::span<const float> values() const noexcept { return m_values; }
+
+        // Same (name, key) rows and every value within tolerance (vectorized, early exit).
+        [[nodiscard]] bool sameAs(const MorphSnapshot& o, float tolerance) const noexcept;
+        // Rows whose value moved by more than tolerance, appended to out. Requires sameRows(o).
+        std::size_t changedRows(const MorphSnapshot& o, float tolerance, std::vector<std::uint32_t>& out) const;
+        [[nodiscard]] bool sameRows(const MorphSnapshot& o) const noexcept;
+
+    private:
+        std::vector<Id> m_names;
+        std::vector<Id> m_keys;
+        std::vector<float> m_values;
+
+        // finish() scratch
+        std::vector<std::uint64_t> m_sort;
+        std::vector<std::uint32_t> m_order;
+        std::vector<float> m_tmp;
+    };
+
+}  // namespace MorphFixer
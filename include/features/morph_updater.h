@@ -1,7 +1,14 @@
 #pragma once
 
+#include <array>
 #include <atomic>
-#include <string>
+#include <cstdint>
+
+#include "core/timer_wheel.h"
+#include "core/ui_task_channel.h"
+#include "features/adaptive_throttle.h"
+#include "features/cadence_engine.h"
+#include "features/morph_snapshot.h"
 
 namespace RE {
     class GFxMovieView;
@@ -13,6 +20,7 @@ namespace SKEE {
 }
 
 namespace MorphFixer {
+    struct EiEvent;
     // forward-declare SKEE type to avoid pulling skee.h in the header
 
     class MorphUpdater {
@@ -22,63 +30,113 @@ namespace MorphFixer {
         MorphUpdater& operator=(const MorphUpdater&) = delete;
 
         // Enable/disable updates (RaceMenuWatcher toggles this with menu open/close)
-        void setEnabled(bool e) { m_enabled.store(e); }
+        void setEnabled(bool e) { m_engine.setEnabled(e); }
 
-        // Driver for gfx-EI calls (TracingExternalInterface::Callback must call this)
-        void onGfxEvent(const char* name, const RE::GFxValue* args, std::uint32_t argc) noexcept;
+        // EiDispatch observer (weight, slider and preset classes, after RaceMenu handled the call)
+        void onGfxEvent(const EiEvent& ev) noexcept;
 
         // Settings / wiring
-        void setThrottleMs(int ms) { m_throttle_ms.store(ms); }
+        void setCadenceConfig(const AdaptiveThrottle::Config& cfg) noexcept;
         void setMorphInterface(SKEE::IBodyMorphInterface* bmi) noexcept;
+        void setRefreshMode(CadenceEngine::RefreshMode mode) noexcept;
+        void setSkipUnchanged(bool on) noexcept;
 
         // Heavy path outside RaceMenu
         void updateModelWeight(RE::TESObjectREFR* refr) noexcept;
 
-        void onMenuClosed() noexcept {
-            m_primed.store(false);
-            m_LastEventName.clear();
-            m_LastAppliedNs.store(-1);
-            m_LastWillApplyNs.store(-1);
-            m_LastWasNudge.store(false);
-            // End any in-progress session and clear baseline
-            m_SessionActive.store(false);
-            m_LastBaselineNorm.store(-1.0);
-        }
+        void onMenuClosed() noexcept;
+
+        // Slider-event coalescing counters (per menu session; logged and reset on close)
+        struct CoalesceStats {
+            std::uint64_t received{0};   // eligible Change* events seen
+            std::uint64_t throttled{0};  // dropped by the throttle window (tail covers them)
+            std::uint64_t merged{0};     // folded into an already-queued UI task
+            std::uint64_t executed{0};   // UI tasks that actually drove ChangeWeight
+        };
+        [[nodiscard]] CoalesceStats coalesceStats() const noexcept;
+
+        // Slider-to-refresh latency histograms (per menu session; logged and reset on close)
+        [[nodiscard]] const CadenceEngine::Latency& latency() const noexcept { return m_engine.latency(); }
 
     private:
-        MorphUpdater() = default;
+        MorphUpdater();
 
         static RE::GFxMovieView* currentRaceMenuMovie() noexcept;
         static bool isRaceMenuOpen() noexcept;
 
-        void applyNudge(RE::GFxMovieView* mv) noexcept;
-        void applyRestore(RE::GFxMovieView* mv) noexcept;
-        void applyNudgeRestore(RE::GFxMovieView* mv) noexcept;
-
-        void ensureTimerThread() noexcept;
-
-        // state
-        std::atomic<bool> m_enabled{false};
-        std::atomic<int> m_throttle_ms{100};  // default; INI may override
-
-        std::string m_LastEventName;
-        std::atomic<long long> m_LastAppliedNs{-1};
-        std::atomic<long long> m_LastWillApplyNs{-1};
-        std::atomic<bool> m_LastWasNudge{false};
-        std::atomic<bool> m_TimerThreadRunning{false};
-
-        // FYI: last arg0 seen from any EI call
-        std::atomic<double> m_LastAnyArg0{0.0};
-
-        // Baseline weight captured for the CURRENT SESSION (in [0,1]; <0 means unset)
-        std::atomic<double> m_LastBaselineNorm{-1.0};
+        // --- CadenceEngine wiring (game side) ---
+        struct SteadyClock final : CadenceEngine::Clock {
+            [[nodiscard]] long long nowNs() const noexcept override;
+        };
+
+        // UiTaskChannel for tasks, the shared TimerWheel for the tail deadline. Settles go through
+        // SKSE's main-thread task queue, which is where SKEE queues its model update: a settle
+        // submitted after the drive runs after the rebuild.
+        struct ChannelSink final : CadenceEngine::TaskSink {
+            bool submit(const UiCommand& cmd) noexcept override;
+            bool submitSettle(const UiCommand& cmd) noexcept override;
+            void armTail(long long dueNs) noexcept override;
+            void cancelTail() noexcept override;
+            [[nodiscard]] std::size_t depth() const noexcept override;
+
+            void ensureTimer() noexcept;
+
+            // Pooled, like UiTaskChannel's pump: no allocation per settle. One drive per frame at
+            // most, so a few slots cover the settles in flight; a full pool drops the sample.
+            struct SettleTask final : SKSE::TaskDelegate {
+                void Run() override { MorphUpdater::get().m_engine.runTask(cmd); }
+                void Dispose() override { busy.store(false, std::memory_order_release); }
+
+                UiCommand cmd;
+                std::atomic<bool> busy{false};
+            };
+
+            std::atomic<TimerWheel::TimerId> m_timer{TimerWheel::INVALID_TIMER};
+            std::array<SettleTask, 4> m_settles;
+        };
+
+        // Last RaceMenu ChangeWeight snapshot, else the player's base weight
+        struct LiveWeight final : CadenceEngine::WeightSource {
+            [[nodiscard]] double currentNorm() noexcept override;
+        };
+
+        // RaceMenu EI for weight drives, SKEE for direct refreshes. The movie is looked up once
+        // per task in ready() (UI thread only).
+        struct MenuDriver final : CadenceEngine::WeightDriver {
+            [[nodiscard]] bool ready() noexcept override;
+            bool drive(double norm) noexcept override;
+            bool nudgeRestore(double norm, double epsilon) noexcept override;
+            [[nodiscard]] bool canRefresh() noexcept override;
+            bool refresh() noexcept override;
+            // Player's SKEE morph values (VisitMorphValues) against the last applied snapshot
+            [[nodiscard]] bool morphsChanged() noexcept override;
+            void resetMorphs() noexcept { m_have_applied = false; }
+            // First snapshot of the game session: pre-intern SKEE's known morph names/keys so snapshots
+            // only look up. Not repeated per menu session; names SKEE learns later are interned on a miss.
+            void seedMorphIds(SKEE::IBodyMorphInterface& bmi);
+
+            RE::GFxMovieView* m_movie{nullptr};
+            std::atomic<SKEE::IBodyMorphInterface*> m_bmi{nullptr};
+
+            // Slider steps are far coarser; this only absorbs float noise from SKEE round-trips
+            static constexpr float MORPH_TOLERANCE = 1e-5f;
+
+            // UI thread only (tasks)
+            MorphStringIds m_morph_ids;
+            MorphSnapshot m_applied;
+            MorphSnapshot m_current;
+            std::vector<std::uint32_t> m_changed;
+            bool m_have_applied{false};
+            bool m_ids_seeded{false};  // the pool outlives menu sessions; resetMorphs keeps it
+        };
+
+        SteadyClock m_clock;
+        ChannelSink m_sink;
+        LiveWeight m_weights;
+        MenuDriver m_driver;
+        CadenceEngine m_engine{m_clock, m_sink, m_weights, m_driver};
 
         // SKEE
         SKEE::IBodyMorphInterface* m_skee_bmi{nullptr};
-
-        std::atomic<bool> m_primed{false};
-
-        // --- Update-session control (NEW) ---
-        std::atomic<bool> m_SessionActive{false};
     };
 }  // namespace MorphFixer
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+namespace MorphFixer {
+    namespace Helpers::Alloc {
+
+#if RMF_COUNT_ALLOCS
+        inline constexpr bool COUNTING = true;
+#else
+        inline constexpr bool COUNTING = false;
+#endif
+
+        // Heap allocations made on the calling thread through this plugin's global operator new
+        // (replaced in alloc_counter.cpp with a counting malloc wrapper). The game, SKSE and other
+        // DLLs have their own allocators and are not seen. Diff two reads to count a span of code.
+        // Only builds with RMF_COUNT_ALLOCS (Debug, the CMake option, the allocation-reporting tools)
+        // replace operator new; elsewhere COUNTING is false and this always reads 0.
+        [[nodiscard]] std::uint64_t threadCount() noexcept;
+
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace MorphFixer {
+    namespace Helpers::Ascii {
+
+        // ASCII case-insensitive comparisons for event and mod-event names. Only A-Z/a-z fold;
+        // other bytes (including UTF-8) compare exactly. Portable replacement for _stricmp/_strnicmp.
+
+        [[nodiscard]] constexpr char toLower(char c) noexcept {
+            return (c >= 'A' && c <= 'Z') ? static_cast<char>(c | 0x20) : c;
+        }
+
+        [[nodiscard]] constexpr bool equalsIgnoreCase(std::string_view a, std::string_view b) noexcept {
+            if (a.size() != b.size()) return false;
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                if (toLower(a[i]) != toLower(b[i])) return false;
+            }
+            return true;
+        }
+
+        // Offset of the first case-insensitive match of needle in hay, or npos. An empty needle
+        // matches at 0. Vectorized (SSE2 / AVX2 / NEON, picked at runtime) with a scalar tail.
+        [[nodiscard]] std::size_t findIgnoreCase(std::string_view hay, std::string_view needle) noexcept;
+
+        [[nodiscard]] inline bool containsIgnoreCase(std::string_view hay, std::string_view needle) noexcept {
+            return findIgnoreCase(hay, needle) != std::string_view::npos;
+        }
+
+        // Reference implementation (also the short-haystack path). Faster than findIgnoreCase on
+        // haystacks of event-name length, where the SIMD setup does not pay off (tools/ascii_check).
+        [[nodiscard]] std::size_t findIgnoreCaseScalar(std::string_view hay, std::string_view needle) noexcept;
+
+    }
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+namespace MorphFixer {
+    namespace Helpers::Cpu {
+
+        // Runtime CPU feature checks (cached after the first call). SSE2 is the x86-64 baseline and
+        // NEON the AArch64 one, so only the optional extensions need asking.
+        [[nodiscard]] bool hasAvx2() noexcept;
+
+    }
+}
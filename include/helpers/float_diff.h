@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace MorphFixer {
+    namespace Helpers::FloatDiff {
+
+        // Element-wise comparison of two equal-length float arrays (morph snapshot values).
+        // An element has changed when !(|a - b| <= tolerance); NaN on either side counts as a
+        // change. Vectorized (AVX2 / SSE2 / NEON, picked at runtime) with a scalar tail; the
+        // scalar versions are the reference. Only the first min(a.size(), b.size()) are compared.
+
+        // True as soon as any element changed (early exit).
+        [[nodiscard]] bool any(std::span<const float> a, std::span<const float> b, float tolerance) noexcept;
+
+        // Indices of every changed element, appended to out in ascending order. Returns how many.
+        std::size_t changed(std::span<const float> a, std::span<const float> b, float tolerance,
+                            std::vector<std::uint32_t>& out);
+
+        [[nodiscard]] bool anyScalar(std::span<const float> a, std::span<const float> b, float tolerance) noexcept;
+        std::size_t changedScalar(std::span<const float> a, std::span<const float> b, float tolerance,
+                                  std::vector<std::uint32_t>& out);
+
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace MorphFixer {
+    namespace Helpers {
+
+        // Fixed-memory log-linear histogram (HDR style) for non-negative integer samples, usually ns.
+        // Each power of two is split into SUB_BUCKETS linear buckets, so any reported value is
+        // within 1/SUB_BUCKETS (~3%) of the true one over the whole 64-bit range. Recording is a
+        // single relaxed fetch_add plus a max CAS: safe from any thread, no locks, no allocation.
+        class LogLinearHistogram {
+        public:
+            static constexpr unsigned SUB_BITS = 5;
+            static constexpr std::uint64_t SUB_BUCKETS = 1ull << SUB_BITS;
+            static constexpr std::size_t BUCKETS = (64 - SUB_BITS + 1) * SUB_BUCKETS;
+
+            struct Summary {
+                std::uint64_t count{0};
+                std::uint64_t p50{0};
+                std::uint64_t p99{0};
+                std::uint64_t max{0};
+            };
+
+            void record(std::uint64_t value) noexcept;
+            void recordSigned(long long value) noexcept { record(value < 0 ? 0 : static_cast<std::uint64_t>(value)); }
+
+            [[nodiscard]] std::uint64_t count() const noexcept { return m_count.load(std::memory_order_relaxed); }
+            [[nodiscard]] std::uint64_t max() const noexcept { return m_max.load(std::memory_order_relaxed); }
+
+            // Upper bound of the bucket holding the q-th quantile (q in [0,1]), capped at max().
+            [[nodiscard]] std::uint64_t percentile(double q) const noexcept;
+            [[nodiscard]] Summary summary() const noexcept;
+
+            void reset() noexcept;
+
+            [[nodiscard]] static constexpr std::size_t bucketOf(std::uint64_t v) noexcept {
+                if (v < SUB_BUCKETS) return static_cast<std::size_t>(v);
+                unsigned msb = 63;
+                while (!(v >> msb)) --msb;
+                const unsigned shift = msb - SUB_BITS;
+                return static_cast<std::size_t>((shift + 1) * SUB_BUCKETS + ((v >> shift) - SUB_BUCKETS));
+            }
+
+            // Largest value that lands in bucket i.
+            [[nodiscard]] static constexpr std::uint64_t bucketHigh(std::size_t i) noexcept {
+                if (i < SUB_BUCKETS) return i;
+                const auto shift = static_cast<unsigned>(i / SUB_BUCKETS - 1);
+                const std::uint64_t lo = (SUB_BUCKETS + i % SUB_BUCKETS) << shift;
+                return lo + ((1ull << shift) - 1);
+            }
+
+        private:
+            std::array<std::atomic<std::uint64_t>, BUCKETS> m_buckets{};
+            std::atomic<std::uint64_t> m_count{0};
+            std::atomic<std::uint64_t> m_max{0};
+        };
+
+        static_assert(LogLinearHistogram::bucketOf(31) == 31);
+        static_assert(LogLinearHistogram::bucketOf(32) == 32 && LogLinearHistogram::bucketOf(63) == 63);
+        static_assert(LogLinearHistogram::bucketOf(64) == 64 && LogLinearHistogram::bucketOf(65) == 64);
+        static_assert(LogLinearHistogram::bucketOf(~0ull) == LogLinearHistogram::BUCKETS - 1);
+        static_assert(LogLinearHistogram::bucketHigh(LogLinearHistogram::bucketOf(1000)) >= 1000);
+
+    }  // namespace Helpers
+}  // namespace MorphFixer
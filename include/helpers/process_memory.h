@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+namespace MorphFixer {
+    namespace Helpers::Process {
+
+        // Private commit of this process in bytes (0 if unavailable).
+        [[nodiscard]] std::uint64_t privateBytes() noexcept;
+
+    }
+}
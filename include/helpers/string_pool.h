@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace MorphFixer {
+    namespace Helpers {
+
+        // Append-only string interner: dense 32-bit ids, O(1) id -> string, open-addressing lookup.
+        // Characters live NUL-terminated in 64 KiB arena blocks, so interning never allocates per
+        // string (only when a block fills or the table grows). Returned views and c_str() pointers
+        // stay valid for the pool's lifetime. Not thread-safe.
+        class StringPool {
+        public:
+            using Id = std::uint32_t;
+            static constexpr Id INVALID_ID = 0xFFFFFFFFu;
+            static constexpr std::size_t BLOCK_BYTES = 64 * 1024;
+
+            StringPool() = default;
+            StringPool(const StringPool&) = delete;
+            StringPool& operator=(const StringPool&) = delete;
+            StringPool(StringPool&&) noexcept = default;
+            StringPool& operator=(StringPool&&) noexcept = default;
+
+            // Existing id for s, or a new one.
+            Id intern(std::string_view s);
+            // Existing id for s, or INVALID_ID. Never inserts.
+            [[nodiscard]] Id find(std::string_view s) const noexcept;
+
+            // Size the table (and first arena block) for a bulk seed of about this many strings.
+            void reserve(std::size_t strings, std::size_t totalChars = 0);
+
+            [[nodiscard]] std::string_view nameOf(Id id) const noexcept;
+            [[nodiscard]] const char* c_str(Id id) const noexcept;
+            [[nodiscard]] std::size_t size() const noexcept { return m_strings.size(); }
+
+            // Heap bytes held: arena blocks, hash table, id index.
+            [[nodiscard]] std::size_t memoryBytes() const noexcept;
+
+        private:
+            struct Slot {
+                std::uint32_t hash{0};
+                Id id{INVALID_ID};
+            };
+            struct Ref {
+                const char* chars;
+                std::uint32_t size;
+            };
+
+            static std::uint32_t hashOf(std::string_view s) noexcept;
+            [[nodiscard]] std::size_t probe(std::string_view s, std::uint32_t h) const noexcept;
+            const char* store(std::string_view s);
+            void rehash(std::size_t capacity);
+
+            std::vector<Slot> m_table;  // power-of-two size, load factor <= 0.75
+            std::vector<Ref> m_strings;  // id -> chars
+            std::vector<std::unique_ptr<char[]>> m_blocks;
+            std::size_t m_block_used{0};
+            std::size_t m_block_size{0};
+            std::size_t m_arena_bytes{0};
+        };
+
+    }
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include <chrono>
+#include <cstddef>
 #include <string_view>
 
 namespace MorphFixer {
@@ -7,7 +8,11 @@ namespace MorphFixer {
         // Print to console + show a notification immediately.
         void notify(std::string_view msg);
 
-        // Same as notify(), but rate-limited per key (to avoid spam).
+        inline constexpr std::size_t MAX_THROTTLE_KEYS = 16;
+
+        // Same as notify(), but rate-limited per key (to avoid spam). Cooldowns run on the
+        // TimerWheel; keys are meant to be call-site literals (at most MAX_THROTTLE_KEYS of them,
+        // further keys are not throttled).
         // Example: notifyThrottled("toggle", "Tracking Vilkas", 1000ms);
         void notifyThrottled(std::string_view key, std::string_view msg, std::chrono::milliseconds cooldown);
 
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace MorphFixer {
 
@@ -16,7 +17,36 @@ namespace MorphFixer {
         std::wstring iniPath() const { return m_ini_path; }      // resolved ini (preferred in self_dir)
 
         // User-tunable values (defaults preserved if keys absent)
-        int throttle_ms = DEFAULT_THROTTLE_MS;  // delay before applying
+        int throttle_ms = DEFAULT_THROTTLE_MS;  // delay before applying (start value when adaptive)
+
+        // Adaptive cadence: throttle and tail idle gap tuned from the measured drive -> mesh rebuilt
+        // time, within bounds
+        bool adaptive = true;
+        int throttle_min_ms = 50;
+        int throttle_max_ms = 400;
+        int idle_gap_ms = 150;  // idle time before the tail flush
+        int idle_gap_min_ms = 75;
+        int idle_gap_max_ms = 600;
+
+        // Refresh mode: false = nudge RaceMenu's weight slider, true = re-apply morphs through SKEE
+        bool refresh_skee = false;
+        // Skip a refresh when the player's body morph values are unchanged since the last one. Off:
+        // the snapshot walks every morph through SKEE before each refresh, on the refresh's path
+        bool skip_unchanged = false;
+
+        // SKEE morph cache: limit scaled between the bounds by process private commit (MB), cleared at safe
+        // points (RaceMenu closed, save loaded) once commit reaches low water
+        bool cache_manage = false;  // off: SKEE keeps its own limit
+        int cache_limit_min_mb = 128;
+        int cache_limit_max_mb = 1024;
+        int cache_low_water_mb = 6144;
+        int cache_high_water_mb = 10240;
+        int cache_poll_ms = 10000;
+
+        // Diagnostics: record ExternalInterface traffic and dump it as *.rmft on menu close
+        bool record_ei = false;
+        // Other menus (by name) whose ExternalInterface calls are counted and traced alongside RaceMenu's
+        std::vector<std::string> observe_menus;
 
         // Load (idempotent). Does not touch other subsystems.
         void load();
@@ -1,7 +1,14 @@
 #pragma once
 
-#include "pch.h"
-// Racemenu's SKEE interface, in header form so sources aren't included
+#include <cstddef>
+#include <cstdint>
+// Racemenu's SKEE interface, in header form so sources aren't included.
+// Only pointers to game types cross it, so it builds without CommonLib (tools/skee_mock).
+
+namespace RE {
+    class NiAVObject;
+    class TESObjectREFR;
+}
 
 namespace SKEE {
     class IPluginInterface {
@@ -9,7 +16,7 @@ namespace SKEE {
         IPluginInterface() {};
         virtual ~IPluginInterface() {};
 
-        virtual uint32_t GetVersion() = 0;
+        virtual std::uint32_t GetVersion() = 0;
         virtual void Revert() = 0;
     };
 
@@ -21,7 +28,7 @@ namespace SKEE {
     };
 
     struct InterfaceExchangeMessage {
-        enum : uint32_t { kExchangeInterface = 0x9E3779B9 };
+        enum : std::uint32_t { kExchangeInterface = 0x9E3779B9 };
 
         IInterfaceMap* interfaceMap = nullptr;
     };
@@ -72,9 +79,9 @@ namespace SKEE {
         virtual void ApplyBodyMorphs(RE::TESObjectREFR* refr, bool deferUpdate = true) = 0;
         virtual void UpdateModelWeight(RE::TESObjectREFR* refr, bool immediate = false) = 0;
 
-        virtual void SetCacheLimit(size_t limit) = 0;
+        virtual void SetCacheLimit(std::size_t limit) = 0;
         virtual bool HasMorphs(RE::TESObjectREFR* actor) = 0;
-        virtual uint32_t EvaluateBodyMorphs(RE::TESObjectREFR* actor) = 0;
+        virtual std::uint32_t EvaluateBodyMorphs(RE::TESObjectREFR* actor) = 0;
 
         virtual bool HasBodyMorph(RE::TESObjectREFR* actor, const char* morphName, const char* morphKey) = 0;
         virtual bool HasBodyMorphName(RE::TESObjectREFR* actor, const char* morphName) = 0;
@@ -82,6 +89,6 @@ namespace SKEE {
         virtual void ClearBodyMorphKeys(RE::TESObjectREFR* actor, const char* morphKey) = 0;
         virtual void VisitStrings(StringVisitor& visitor) = 0;
         virtual void VisitActors(ActorVisitor& visitor) = 0;
-        virtual size_t ClearMorphCache() = 0;
+        virtual std::size_t ClearMorphCache() = 0;
     };
 }  // namespace SKEE
\ No newline at end of file
@@ -0,0 +1,53 @@
+#include "core/arg0_sequence.h"
+
+#include <cmath>
+
+namespace MorphFixer {
+    namespace {
+        constexpr std::int64_t NONE = -1;
+        // RaceMenu counts from 0 in a double; anything past 2^53 has stopped being a counter.
+        constexpr double MAX_SLOT = 9007199254740992.0;
+    }
+
+    Arg0Sequence::Arg0Sequence() noexcept {
+        for (auto& r : m_recent) r.store(NONE, std::memory_order_relaxed);
+    }
+
+    std::int64_t Arg0Sequence::reserve(std::uint32_t count) noexcept {
+        if (count == 0) count = 1;
+        const auto base = m_next.fetch_add(count, std::memory_order_acq_rel);
+        for (std::uint32_t k = 0; k < count; ++k) {
+            const auto slot = base + k;
+            m_recent[static_cast<std::size_t>(slot) % WINDOW].store(slot, std::memory_order_release);
+        }
+        m_reserved.fetch_add(count, std::memory_order_relaxed);
+        return base;
+    }
+
+    bool Arg0Sequence::observe(double arg0) noexcept {
+        if (!std::isfinite(arg0) || arg0 < 0.0 || arg0 >= MAX_SLOT) return false;
+        const auto slot = std::llround(arg0);
+        m_observed.fetch_add(1, std::memory_order_relaxed);
+
+        // High-water mark: never hand out a slot RaceMenu already used
+        auto next = m_next.load(std::memory_order_relaxed);
+        while (next <= slot && !m_next.compare_exchange_weak(next, slot + 1, std::memory_order_acq_rel)) {
+        }
+
+        if (m_recent[static_cast<std::size_t>(slot) % WINDOW].load(std::memory_order_acquire) != slot) return false;
+        m_collisions.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void Arg0Sequence::resetStats() noexcept {
+        m_reserved.store(0, std::memory_order_relaxed);
+        m_observed.store(0, std::memory_order_relaxed);
+        m_collisions.store(0, std::memory_order_relaxed);
+    }
+
+    Arg0Sequence::Stats Arg0Sequence::stats() const noexcept {
+        return {m_reserved.load(std::memory_order_relaxed), m_observed.load(std::memory_order_relaxed),
+                m_collisions.load(std::memory_order_relaxed), m_next.load(std::memory_order_relaxed)};
+    }
+
+}  // namespace MorphFixer
@@ -0,0 +1,26 @@
+#include "core/ei_dispatch.h"
+
+namespace MorphFixer {
+
+    EiDispatch& EiDispatch::get() {
+        static EiDispatch s;
+        return s;
+    }
+
+    bool EiDispatch::subscribe(Phase phase, ClassMask classes, Observer fn) noexcept {
+        if (!fn) return false;
+        auto& rows = m_rows[static_cast<std::size_t>(phase)];
+        bool ok = true;
+        for (std::size_t c = 0; c < rows.size(); ++c) {
+            if (!((classes >> c) & 1)) continue;
+            auto& row = rows[c];
+            if (row.count >= MAX_OBSERVERS) {
+                ok = false;  // row full: the observer misses this class
+                continue;
+            }
+            row.fns[row.count++] = fn;
+        }
+        return ok;
+    }
+
+}  // namespace MorphFixer
@@ -0,0 +1,26 @@
+#include "core/ei_dispatch.h"
+
+#include "RE/G/GFxValue.h"
+
+namespace MorphFixer {
+
+    EiEvent EiEvent::decode(const char* name, const RE::GFxValue* args, std::uint32_t argc) noexcept {
+        EiEvent ev;
+        ev.name = name;
+        ev.argc = args ? argc : 0;
+        ev.args = args;
+        if (name) {
+            const auto info = Helpers::EventNames::resolve(name);
+            ev.id = info.id;
+            ev.cls = info.cls;
+        }
+        const auto n = std::min(ev.argc, MAX_NUMERIC);
+        for (std::uint32_t i = 0; i < n; ++i) {
+            if (!args[i].IsNumber()) continue;
+            ev.num[i] = args[i].GetNumber();
+            ev.numericMask |= 1u << i;
+        }
+        return ev;
+    }
+
+}  // namespace MorphFixer
@@ -0,0 +1,19 @@
+#include "core/ei_event_classifier.h"
+
+namespace MorphFixer {
+    namespace Helpers::EventClassifier {
+
+        EventClass classifyFallback(std::string_view name) noexcept {
+            if (const auto known = classifyKnown(name); known != EventClass::kUnknown) return known;
+
+            // Scalar search: on names this short it beats the SIMD dispatch (tools/ascii_check)
+            const bool change = name.find("Change") != std::string_view::npos;
+            if (Ascii::findIgnoreCaseScalar(name, "Preset") != std::string_view::npos) {
+                return change ? EventClass::kPresetChange : EventClass::kPreset;
+            }
+            if (change) return EventClass::kSlider;
+            return EventClass::kUnknown;
+        }
+
+    }  // namespace Helpers::EventClassifier
+}  // namespace MorphFixer
@@ -0,0 +1,105 @@
+#include "core/ei_event_names.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+namespace MorphFixer {
+    namespace {
+        using Helpers::EventClassifier::EventClass;
+        using Helpers::EventClassifier::VOCABULARY;
+        using Helpers::EventClassifier::VOCABULARY_SIZE;
+        using Helpers::EventNames::EventId;
+        using Helpers::EventNames::EventInfo;
+        using Helpers::EventNames::NO_EVENT;
+
+        constexpr std::size_t CAPACITY = 256;  // power of two; RaceMenu uses a few dozen names
+        constexpr std::size_t MAX_NAME = 47;
+
+        constexpr std::uint64_t EMPTY = 0;
+        constexpr std::uint64_t BUSY = 1;  // claimed, name being written
+
+        struct Slot {
+            std::atomic<std::uint64_t> key{EMPTY};  // hash once published
+            std::uint8_t len{0};
+            EventClass cls{EventClass::kUnknown};
+            char name[MAX_NAME + 1]{};
+        };
+
+        std::array<Slot, CAPACITY> g_slots;
+
+        constexpr std::uint64_t hashName(std::string_view s) noexcept {
+            std::uint64_t h = 14695981039346656037ULL;  // FNV-1a
+            for (const char c : s) {
+                h ^= static_cast<unsigned char>(c);
+                h *= 1099511628211ULL;
+            }
+            return h <= BUSY ? h + 2 : h;
+        }
+
+        bool sameName(const Slot& slot, std::string_view s) noexcept {
+            const auto n = std::min(s.size(), MAX_NAME);
+            return slot.len == n && std::memcmp(slot.name, s.data(), n) == 0;
+        }
+
+        constexpr EventId dynamicId(std::size_t slot) noexcept { return static_cast<EventId>(VOCABULARY_SIZE + 1 + slot); }
+    }
+
+    namespace Helpers::EventNames {
+
+        EventInfo resolve(std::string_view name) noexcept {
+            if (name.empty()) return {};
+
+            if (const auto known = EventClassifier::vocabularyIndex(name); known >= 0) {
+                return {static_cast<EventId>(known + 1), VOCABULARY[known].cls};
+            }
+
+            const auto h = hashName(name);
+            for (std::size_t probe = 0; probe < CAPACITY; ++probe) {
+                const auto i = (h + probe) & (CAPACITY - 1);
+                auto& slot = g_slots[i];
+
+                auto key = slot.key.load(std::memory_order_acquire);
+                if (key == EMPTY) {
+                    if (slot.key.compare_exchange_strong(key, BUSY, std::memory_order_acquire)) {
+                        const auto n = std::min(name.size(), MAX_NAME);
+                        std::memcpy(slot.name, name.data(), n);
+                        slot.name[n] = '\0';
+                        slot.len = static_cast<std::uint8_t>(n);
+                        slot.cls = EventClassifier::classifyFallback(name);
+                        slot.key.store(h, std::memory_order_release);
+                        return {dynamicId(i), slot.cls};
+                    }
+                    // lost the race: 'key' now holds the winner's value, fall through
+                }
+                while (key == BUSY) {
+                    std::this_thread::yield();  // writer is a memcpy away from publishing
+                    key = slot.key.load(std::memory_order_acquire);
+                }
+                if (key == h && sameName(slot, name)) {
+                    return {dynamicId(i), slot.cls};
+                }
+            }
+            return {};
+        }
+
+        EventClass classOf(EventId id) noexcept {
+            if (id == NO_EVENT) return EventClass::kUnknown;
+            if (id <= VOCABULARY_SIZE) return VOCABULARY[id - 1].cls;
+            const auto i = static_cast<std::size_t>(id - VOCABULARY_SIZE - 1);
+            if (i >= CAPACITY || g_slots[i].key.load(std::memory_order_acquire) <= BUSY) return EventClass::kUnknown;
+            return g_slots[i].cls;
+        }
+
+        std::string_view nameOf(EventId id) noexcept {
+            if (id == NO_EVENT) return {};
+            if (id <= VOCABULARY_SIZE) return VOCABULARY[id - 1].name;
+            const auto i = static_cast<std::size_t>(id - VOCABULARY_SIZE - 1);
+            if (i >= CAPACITY || g_slots[i].key.load(std::memory_order_acquire) <= BUSY) return {};
+            return {g_slots[i].name, g_slots[i].len};
+        }
+
+    }  // namespace Helpers::EventNames
+}  // namespace MorphFixer
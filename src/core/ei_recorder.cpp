@@ -0,0 +1,160 @@
+#include "core/ei_recorder.h"
+
+#include "core/ei_event_names.h"
+#include "logger.h"
+
+#ifndef PLUGIN_NAME
+    #define PLUGIN_NAME "RacemenuMorphFixer"
+#endif
+
+namespace MorphFixer {
+    namespace {
+        using Helpers::EiTrace::ArgType;
+        using Helpers::EiTrace::Origin;
+
+        thread_local bool t_in_driver = false;
+
+        inline long long now_ns() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+        }
+
+        inline void storeArg(const RE::GFxValue& v, ArgType& type, double& value) {
+            value = 0.0;
+            switch (v.GetType()) {
+                case RE::GFxValue::ValueType::kUndefined:
+                    type = ArgType::kUndefined;
+                    break;
+                case RE::GFxValue::ValueType::kNull:
+                    type = ArgType::kNull;
+                    break;
+                case RE::GFxValue::ValueType::kBoolean:
+                    type = ArgType::kBool;
+                    value = v.GetBool() ? 1.0 : 0.0;
+                    break;
+                case RE::GFxValue::ValueType::kNumber:
+                    type = ArgType::kNumber;
+                    value = v.GetNumber();
+                    break;
+                case RE::GFxValue::ValueType::kString:
+                    type = ArgType::kString;
+                    break;
+                default:
+                    type = ArgType::kOther;
+                    break;
+            }
+        }
+    }
+
+    EiRecorder& EiRecorder::get() {
+        static EiRecorder s;
+        return s;
+    }
+
+    EiRecorder::DriverScope::DriverScope() noexcept : m_prev(t_in_driver) { t_in_driver = true; }
+
+    EiRecorder::DriverScope::~DriverScope() { t_in_driver = m_prev; }
+
+    bool EiRecorder::DriverScope::active() noexcept { return t_in_driver; }
+
+    void EiRecorder::record(const char* name, const RE::GFxValue* args, std::uint32_t argc) noexcept {
+        if (!m_enabled.load(std::memory_order_relaxed) || !name) return;
+
+        // Resolve outside the slot: interning is lock-free but may touch the dynamic table.
+        const auto id = Helpers::EventNames::intern(name);
+        const auto t = now_ns();
+
+        const auto idx = m_head.fetch_add(1, std::memory_order_relaxed);
+        auto& slot = m_slots[idx & (CAPACITY - 1)];
+
+        // Seqlock write: readers skip a slot whose sequence changes under them.
+        slot.seq.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        auto& r = slot.rec;
+        r.t_ns = t;
+        r.id = id;
+        r.argc = static_cast<std::uint8_t>(std::min<std::uint32_t>(argc, 0xFF));
+        r.origin = t_in_driver ? Origin::kDriver : Origin::kRaceMenu;
+        for (std::size_t i = 0; i < Helpers::EiTrace::MAX_ARGS; ++i) {
+            if (args && i < argc) {
+                storeArg(args[i], r.types[i], r.values[i]);
+            } else {
+                r.types[i] = ArgType::kUndefined;
+                r.values[i] = 0.0;
+            }
+        }
+
+        slot.seq.store(idx + 1, std::memory_order_release);
+    }
+
+    void EiRecorder::clear() noexcept { m_start.store(m_head.load(std::memory_order_relaxed), std::memory_order_relaxed); }
+
+    std::uint64_t EiRecorder::snapshot(std::vector<Record>& out) const {
+        const auto head = m_head.load(std::memory_order_acquire);
+        const auto start = m_start.load(std::memory_order_relaxed);
+        const auto from = (head - start > CAPACITY) ? head - CAPACITY : start;
+
+        out.clear();
+        out.reserve(static_cast<std::size_t>(head - from));
+        std::uint64_t lost = from - start;
+        for (auto idx = from; idx < head; ++idx) {
+            const auto& slot = m_slots[idx & (CAPACITY - 1)];
+            const auto s1 = slot.seq.load(std::memory_order_acquire);
+            if (s1 != idx + 1) {
+                ++lost;  // still being written, or already overwritten
+                continue;
+            }
+            const Record copy = slot.rec;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) != s1) {
+                ++lost;
+                continue;
+            }
+            out.push_back(copy);
+        }
+        return lost;
+    }
+
+    bool EiRecorder::dumpSession() {
+        if (!enabled()) return false;
+
+        Helpers::EiTrace::Trace trace;
+        trace.lost = snapshot(trace.records);
+        clear();
+        if (trace.records.empty()) return false;
+
+        // Relative timestamps + a per-file name table (dynamic ids are only stable per process)
+        trace.base_ns = trace.records.front().t_ns;
+        std::vector<std::uint16_t> ids;
+        for (auto& r : trace.records) {
+            r.t_ns -= trace.base_ns;
+            if (std::find(ids.begin(), ids.end(), r.id) == ids.end()) ids.push_back(r.id);
+        }
+        trace.names.reserve(ids.size());
+        for (const auto id : ids) trace.names.push_back({id, std::string{Helpers::EventNames::nameOf(id)}});
+
+        const auto dir = SKSE::log::log_directory();
+        if (!dir) {
+            LOG_WARN("[ei-rec] no log directory; trace dropped");
+            return false;
+        }
+        const auto secs = std::chrono::duration_cast<std::chrono::seconds>(
+                              std::chrono::system_clock::now().time_since_epoch())
+                              .count();
+        const auto path = *dir / PLUGIN_NAME / ("ei_" + std::to_string(secs) + ".rmft");
+
+        std::error_code ec;
+        std::filesystem::create_directories(path.parent_path(), ec);
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out || !Helpers::EiTrace::write(out, trace)) {
+            LOG_WARN("[ei-rec] failed to write {}", path.string());
+            return false;
+        }
+
+        LOG_INFO("[ei-rec] wrote {} records ({} lost) to {}", trace.records.size(), trace.lost, path.string());
+        return true;
+    }
+
+}  // namespace MorphFixer
@@ -0,0 +1,27 @@
+#include "core/ei_session.h"
+
+#include "RE/G/GFxExternalInterface.h"
+#include "RE/G/GFxMovieView.h"
+#include "logger.h"
+
+namespace MorphFixer {
+
+    EiSession& EiSession::get() {
+        static EiSession s;
+        return s;
+    }
+
+    std::uint32_t EiSession::open(RE::GFxMovieView* mv, ExternalInterfaceRef ei) noexcept {
+        auto* pinned = ei.get();
+        const auto gen = BasicEiSession::open(mv, std::move(ei));
+        if (gen) LOG_DEBUG("[gfx-ei] session {} pinned EI {} on movie {}", gen, fmt::ptr(pinned), fmt::ptr(mv));
+        return gen;
+    }
+
+    std::uint32_t EiSession::close() noexcept {
+        const auto gen = BasicEiSession::close();
+        if (gen) LOG_DEBUG("[gfx-ei] session released (generation {})", gen);
+        return gen;
+    }
+
+}  // namespace MorphFixer
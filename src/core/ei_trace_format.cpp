@@ -0,0 +1,136 @@
+#include "core/ei_trace_format.h"
+
+#include <algorithm>
+#include <bit>
+#include <istream>
+#include <ostream>
+#include <type_traits>
+
+namespace MorphFixer {
+    namespace {
+        using namespace Helpers::EiTrace;
+
+        template <class T>
+        void put(std::ostream& out, T v) {
+            static_assert(std::is_integral_v<T>);
+            using U = std::make_unsigned_t<T>;
+            auto u = static_cast<U>(v);
+            for (std::size_t i = 0; i < sizeof(T); ++i) {
+                out.put(static_cast<char>(u & 0xFF));
+                u = static_cast<U>(u >> 8);
+            }
+        }
+
+        void putF64(std::ostream& out, double v) { put(out, std::bit_cast<std::uint64_t>(v)); }
+
+        template <class T>
+        bool get(std::istream& in, T& v) {
+            static_assert(std::is_integral_v<T>);
+            using U = std::make_unsigned_t<T>;
+            U u = 0;
+            for (std::size_t i = 0; i < sizeof(T); ++i) {
+                const int c = in.get();
+                if (c == std::char_traits<char>::eof()) return false;
+                u = static_cast<U>(u | (static_cast<U>(static_cast<unsigned char>(c)) << (8 * i)));
+            }
+            v = static_cast<T>(u);
+            return true;
+        }
+
+        bool getF64(std::istream& in, double& v) {
+            std::uint64_t u = 0;
+            if (!get(in, u)) return false;
+            v = std::bit_cast<double>(u);
+            return true;
+        }
+
+        bool fail(std::string* error, const char* what) {
+            if (error) *error = what;
+            return false;
+        }
+    }
+
+    namespace Helpers::EiTrace {
+
+        std::string_view Trace::nameOf(std::uint16_t id) const noexcept {
+            for (const auto& n : names) {
+                if (n.id == id) return n.name;
+            }
+            return "<unknown>";
+        }
+
+        bool write(std::ostream& out, const Trace& trace) {
+            out.write(MAGIC.data(), MAGIC.size());
+            put(out, VERSION);
+            put(out, static_cast<std::uint16_t>(MAX_ARGS));
+            put(out, static_cast<std::uint32_t>(trace.names.size()));
+            put(out, static_cast<std::uint32_t>(trace.records.size()));
+            put(out, trace.lost);
+            put(out, trace.base_ns);
+
+            for (const auto& n : trace.names) {
+                const auto len = std::min<std::size_t>(n.name.size(), 0xFF);
+                put(out, n.id);
+                put(out, static_cast<std::uint8_t>(len));
+                out.write(n.name.data(), static_cast<std::streamsize>(len));
+            }
+
+            for (const auto& r : trace.records) {
+                put(out, r.t_ns);
+                put(out, r.id);
+                put(out, r.argc);
+                put(out, static_cast<std::uint8_t>(r.origin));
+                for (const auto t : r.types) put(out, static_cast<std::uint8_t>(t));
+                for (const auto v : r.values) putF64(out, v);
+            }
+            return static_cast<bool>(out);
+        }
+
+        bool read(std::istream& in, Trace& out, std::string* error) {
+            out = {};
+
+            std::array<char, 4> magic{};
+            if (!in.read(magic.data(), magic.size()) || magic != MAGIC) return fail(error, "not an RMFT trace");
+
+            std::uint16_t version = 0, maxArgs = 0;
+            std::uint32_t nameCount = 0, recordCount = 0;
+            if (!get(in, version) || !get(in, maxArgs) || !get(in, nameCount) || !get(in, recordCount) ||
+                !get(in, out.lost) || !get(in, out.base_ns)) {
+                return fail(error, "truncated header");
+            }
+            if (version != VERSION) return fail(error, "unsupported trace version");
+            if (maxArgs != MAX_ARGS) return fail(error, "unsupported argument width");
+
+            out.names.reserve(nameCount);
+            for (std::uint32_t i = 0; i < nameCount; ++i) {
+                Name n;
+                std::uint8_t len = 0;
+                if (!get(in, n.id) || !get(in, len)) return fail(error, "truncated name table");
+                n.name.resize(len);
+                if (len && !in.read(n.name.data(), len)) return fail(error, "truncated name table");
+                out.names.push_back(std::move(n));
+            }
+
+            out.records.reserve(recordCount);
+            for (std::uint32_t i = 0; i < recordCount; ++i) {
+                Record r;
+                std::uint8_t origin = 0;
+                if (!get(in, r.t_ns) || !get(in, r.id) || !get(in, r.argc) || !get(in, origin)) {
+                    return fail(error, "truncated record");
+                }
+                r.origin = static_cast<Origin>(origin);
+                for (auto& t : r.types) {
+                    std::uint8_t b = 0;
+                    if (!get(in, b)) return fail(error, "truncated record");
+                    t = static_cast<ArgType>(b);
+                }
+                for (auto& v : r.values) {
+                    if (!getF64(in, v)) return fail(error, "truncated record");
+                }
+                out.records.push_back(r);
+            }
+            return true;
+        }
+
+    }  // namespace Helpers::EiTrace
+}  // namespace MorphFixer
@@ -0,0 +1,127 @@
+#include "core/ei_tracepoint.h"
+
+#if RMF_ENABLE_EI_TRACE
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#include "core/timer_wheel.h"
+
+namespace MorphFixer {
+    namespace {
+        using EiTracepoints::Entry;
+
+        constexpr std::size_t RING = 1024;  // per thread, power of two
+        constexpr std::size_t MAX_THREADS = 16;
+        constexpr auto DRAIN_DELAY = std::chrono::milliseconds(50);
+
+        // Single producer (owning thread), single consumer (drain, under s_drain_mutex).
+        struct ThreadRing {
+            std::array<Entry, RING> entries{};
+            std::atomic<std::uint64_t> head{0};
+            std::atomic<std::uint64_t> tail{0};
+            std::atomic<std::uint64_t> dropped{0};
+        };
+
+        // Rings are never freed: a thread may exit with entries still pending.
+        std::array<std::atomic<ThreadRing*>, MAX_THREADS> s_rings{};
+        std::atomic<std::size_t> s_ring_count{0};
+        std::atomic_bool s_drain_armed{false};
+        std::mutex s_drain_mutex;
+        EiTracepoints::Writer s_writer;  // under s_drain_mutex
+
+        void drainLocked() {
+            s_drain_armed.store(false, std::memory_order_release);  // later emits arm the next window
+
+            const auto now = TimerWheel::nowNs();
+            const auto count = std::min(s_ring_count.load(std::memory_order_acquire), MAX_THREADS);
+            for (std::size_t i = 0; i < count; ++i) {
+                auto* ring = s_rings[i].load(std::memory_order_acquire);
+                if (!ring) continue;
+
+                const auto head = ring->head.load(std::memory_order_acquire);
+                auto tail = ring->tail.load(std::memory_order_relaxed);
+                for (; tail != head; ++tail) {
+                    if (s_writer.entry) s_writer.entry(ring->entries[tail & (RING - 1)], now);
+                }
+                ring->tail.store(tail, std::memory_order_release);
+
+                if (const auto lost = ring->dropped.exchange(0, std::memory_order_relaxed); lost && s_writer.lost) {
+                    s_writer.lost(lost);
+                }
+            }
+        }
+
+        // Drains once more during static destruction. Created with the first ring, i.e. after the
+        // logger, so it is destroyed (and drains) before the logger goes away. Never waits: at
+        // process exit the timer thread has already been killed, possibly inside drain().
+        struct DrainAtExit {
+            ~DrainAtExit() {
+                std::unique_lock lk(s_drain_mutex, std::try_to_lock);
+                if (lk) drainLocked();
+            }
+        };
+
+        ThreadRing* ringForThisThread() noexcept {
+            thread_local ThreadRing* t_ring = []() -> ThreadRing* {
+                static DrainAtExit s_drain_at_exit;
+                const auto i = s_ring_count.fetch_add(1, std::memory_order_relaxed);
+                if (i >= MAX_THREADS) return nullptr;
+                auto* r = new (std::nothrow) ThreadRing();
+                s_rings[i].store(r, std::memory_order_release);
+                return r;
+            }();
+            return t_ring;
+        }
+
+        TimerWheel::TimerId drainTimer() {
+            static const TimerWheel::TimerId id = TimerWheel::get().create([] { EiTracepoints::drain(); });
+            return id;
+        }
+    }
+
+    namespace EiTracepoints {
+
+        void setWriter(const Writer w) noexcept {
+            std::lock_guard lk(s_drain_mutex);
+            s_writer = w;
+        }
+
+        void record(const char* name, std::uint32_t argc, const std::array<double, NUM_ARGS>& num,
+                    std::uint8_t numeric) noexcept {
+            auto* ring = ringForThisThread();
+            if (!ring) return;
+
+            const auto head = ring->head.load(std::memory_order_relaxed);
+            if (head - ring->tail.load(std::memory_order_acquire) >= RING) {
+                ring->dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            auto& e = ring->entries[head & (RING - 1)];
+            e.t_ns = TimerWheel::nowNs();
+            e.name_len = static_cast<std::uint8_t>(strnlen(name, NAME_CHARS));
+            std::memcpy(e.name.data(), name, e.name_len);
+            e.argc = static_cast<std::uint8_t>(std::min<std::uint32_t>(argc, 0xFF));
+            e.numeric = numeric;
+            e.num = num;
+            ring->head.store(head + 1, std::memory_order_release);
+
+            // One timer arm per drain window, not per call
+            if (!s_drain_armed.exchange(true, std::memory_order_acq_rel)) {
+                TimerWheel::get().arm(drainTimer(), DRAIN_DELAY);
+            }
+        }
+
+        void drain() {
+            std::lock_guard lk(s_drain_mutex);
+            drainLocked();
+        }
+
+    }
+}  // namespace MorphFixer
+#endif  // RMF_ENABLE_EI_TRACE
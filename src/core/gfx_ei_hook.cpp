@@ -5,8 +5,11 @@
 #include "RE/G/GFxState.h"
 #include "RE/G/GFxStateBag.h"
 #include "RE/G/GFxValue.h"
-#include "core/racemenu_ei_driver.h"
-#include "features/morph_updater.h"
+#include "core/ei_dispatch.h"
+#include "core/ei_proxy_registry.h"
+#include "core/ei_recorder.h"
+#include "core/ei_session.h"
+#include "core/ei_tracepoint.h"
 #include "logger.h"
 
 namespace MorphFixer {
@@ -14,96 +17,132 @@ namespace MorphFixer {
 
         class TracingExternalInterface : public RE::GFxExternalInterface {
         public:
-            TracingExternalInterface(RE::GFxExternalInterface* orig) : orig_(orig) {
-                if (orig_) {
-                    orig_->AddRef();
-                }
-            }
-
-            ~TracingExternalInterface() override {
-                if (orig_) {
-                    // orig_->Release();
-                    orig_ = nullptr;
-                }
-            }
-
             void Callback(RE::GFxMovieView* movie, const char* name, const RE::GFxValue* args,
                           std::uint32_t argc) override {
-                // Observe/log first for visibility
-                Helpers::RaceMenuExternalInterface::observe(name, args, argc);
-
-                // (Optional) lightweight printf of first args
-                if (name) {
-                    auto arg0 = (argc >= 1 && args[0].IsNumber()) ? args[0].GetNumber() : 0.0;
-                    auto arg1 = (argc >= 2 && args[1].IsNumber()) ? args[1].GetNumber() : 0.0;
-                    auto arg2 = (argc >= 3 && args[2].IsNumber()) ? args[2].GetNumber() : 0.0;
-                    LOG_DEBUG("[gfx-ei] {}(argc={}) [0]=num:{:.3f} [1]=num:{:.3f} [2]=num:{:.3f}", name, argc, arg0,
-                              arg1, arg2);
+                m_calls.fetch_add(1, std::memory_order_relaxed);
+                // Read once: a re-enable may flip it between calls, never within one
+                const bool route = m_route.load(std::memory_order_relaxed);
+                // Only the routed movie's calls go into the recorded session; observed menus are counted
+                if (route) EiRecorder::get().record(name, args, argc);
+
+                // Decode once for every observer, and let the "before" ones see it first
+                EiEvent ev;
+                if (route) {
+                    ev = EiEvent::decode(name, args, argc);
+                    EiDispatch::get().dispatch(EiDispatch::Phase::kBeforeOriginal, ev);
                 }
 
+                // Deferred tracepoint (RMF_ENABLE_EI_TRACE builds only): formatted off the UI thread
+                RMF_EI_TRACE(name, args, argc);
+
                 // Let RaceMenu handle its event first (safer ordering)
                 if (orig_) {
-                    orig_->Callback(movie, name, args, argc);
+                    orig_.get()->Callback(movie, name, args, argc);
                 }
 
-                // Route EI to our morph cadence AFTER original handling.
-                MorphUpdater::get().onGfxEvent(name, args, argc);
+                // Observers that need RaceMenu's own handling done (morph cadence)
+                if (route) {
+                    m_routed.fetch_add(1, std::memory_order_relaxed);
+                    EiDispatch::get().dispatch(EiDispatch::Phase::kAfterOriginal, ev);
+                }
             }
 
-            RE::GFxExternalInterface* orig_{nullptr};
+            // Pooled: bound to a movie on enable, unbound (original released) on disable.
+            void bind(ExternalInterfaceRef orig, bool route) noexcept {
+                orig_ = std::move(orig);
+                m_route.store(route, std::memory_order_relaxed);
+                m_calls.store(0, std::memory_order_relaxed);
+                m_routed.store(0, std::memory_order_relaxed);
+            }
+            void unbind() noexcept {
+                m_route.store(false, std::memory_order_relaxed);
+                orig_.reset();
+            }
+            void setRoute(bool route) noexcept { m_route.store(route, std::memory_order_relaxed); }
+
+            [[nodiscard]] std::uint64_t calls() const noexcept { return m_calls.load(std::memory_order_relaxed); }
+            [[nodiscard]] std::uint64_t routed() const noexcept { return m_routed.load(std::memory_order_relaxed); }
+            [[nodiscard]] RE::GFxExternalInterface* original() const noexcept { return orig_.get(); }
+            [[nodiscard]] bool isRouted() const noexcept { return m_route.load(std::memory_order_relaxed); }
+
+        private:
+            ExternalInterfaceRef orig_;
+            std::atomic<bool> m_route{false};
+            std::atomic<std::uint64_t> m_calls{0};
+            std::atomic<std::uint64_t> m_routed{0};
         };
 
-        // Single-movie installation (RaceMenu)
-        static TracingExternalInterface* s_proxy{nullptr};
-        static RE::GFxMovieView* s_movie{nullptr};
+        struct GfxTraits {
+            using Movie = RE::GFxMovieView;
+            using EI = RE::GFxExternalInterface;
+            using Proxy = TracingExternalInterface;
+
+            static EI* stateAddRef(Movie* mv) {
+                auto* st = mv->GetStateAddRef(RE::GFxState::StateType::kExternalInterface);
+                return static_cast<EI*>(st);
+            }
+            static void setState(Movie* mv, EI* ei) { mv->SetState(RE::GFxState::StateType::kExternalInterface, ei); }
+        };
 
-        static RE::GFxExternalInterface* get_ei_addref(RE::GFxMovieView* mv) {
-            if (!mv) return nullptr;
-            auto* st = mv->GetStateAddRef(RE::GFxState::StateType::kExternalInterface);
-            return static_cast<RE::GFxExternalInterface*>(st);
+        using ProxyRegistry = EiProxyRegistry<GfxTraits>;
+        static ProxyRegistry s_registry;
+
+#if RMF_ENABLE_EI_TRACE
+        // Tracepoint writer: the per-call line the proxy used to log inline, now on the timer thread
+        void logTrace(const EiTracepoints::Entry& e, long long nowNs) {
+            const std::string_view name(e.name.data(), e.name_len);
+            const auto n = [&](std::size_t i) { return (e.numeric >> i) & 1 ? e.num[i] : 0.0; };
+            LOG_DEBUG("[gfx-ei] {}(argc={}) [0]=num:{:.3f} [1]=num:{:.3f} [2]=num:{:.3f} (+{} us)", name, e.argc, n(0),
+                      n(1), n(2), (nowNs - e.t_ns) / 1000);
+        }
+
+        void logTraceLost(std::uint64_t dropped) {
+            LOG_WARN("[gfx-ei] trace buffer full: {} tracepoints dropped", dropped);
         }
+#endif
 
     }  // namespace
 
     namespace Hooks::GfxExternalInterface {
 
-        bool enable(RE::GFxMovieView* mv) {
-            if (!mv) return false;
-            if (s_movie == mv && s_proxy) {
-                // already installed
-                return true;
+        bool enable(RE::GFxMovieView* mv, bool routeToMorphUpdater) {
+#if RMF_ENABLE_EI_TRACE
+            static const bool s_trace_writer = (EiTracepoints::setWriter({logTrace, logTraceLost}), true);
+            (void)s_trace_writer;
+#endif
+            switch (s_registry.install(mv, routeToMorphUpdater, EiSession::get())) {
+                case ProxyRegistry::Install::kInstalled:
+                    LOG_INFO("[gfx-ei] installed proxy EI for movie {} (orig {}, routed={})", fmt::ptr(mv),
+                             fmt::ptr(s_registry.lookup(mv)->proxy->original()), routeToMorphUpdater);
+                    return true;
+                case ProxyRegistry::Install::kRerouted:
+                    LOG_INFO("[gfx-ei] movie {} already proxied, routed={}", fmt::ptr(mv), routeToMorphUpdater);
+                    return true;
+                case ProxyRegistry::Install::kAlreadyInstalled:
+                    return true;
+                case ProxyRegistry::Install::kNoInterface:
+                    if (mv) LOG_WARN("[gfx-ei] movie has no EI");
+                    return false;
+                case ProxyRegistry::Install::kFull:
+                    LOG_WARN("[gfx-ei] no free proxy slot ({} movies proxied)", ProxyRegistry::MAX_MOVIES);
+                    return false;
             }
-
-            auto* ei = get_ei_addref(mv);
-            if (!ei) {
-                LOG_WARN("[gfx-ei] movie has no EI");
-                return false;
-            }
-
-            // Wrap the existing EI with our tracing proxy
-            s_proxy = new TracingExternalInterface(ei);
-
-            // Point the movie at our proxy
-            mv->SetState(RE::GFxState::StateType::kExternalInterface, s_proxy);
-            s_movie = mv;
-
-            LOG_INFO("[gfx-ei] installed proxy EI for movie {} (orig {})", fmt::ptr(mv), fmt::ptr(ei));
-            LOG_INFO("[gfx-ei] enabled");
-            return true;
+            return false;
         }
 
         void disable(RE::GFxMovieView* mv) {
-            if (!mv || !s_proxy) return;
-
-            // Restore original EI (proxy holds the ref)
-            mv->SetState(RE::GFxState::StateType::kExternalInterface, s_proxy->orig_);
-
-            // Drop our proxy (will Release original)
-            delete s_proxy;
-            s_proxy = nullptr;
-            s_movie = nullptr;
+            if (const auto* proxy = s_registry.remove(mv, EiSession::get())) {
+                LOG_INFO("[gfx-ei] removed proxy EI from movie {} (calls={}, routed={})", fmt::ptr(mv), proxy->calls(),
+                         proxy->routed());
+            }
+        }
 
-            LOG_INFO("[gfx-ei] disabled");
+        bool callStats(RE::GFxMovieView* mv, std::uint64_t& calls, std::uint64_t& routed) {
+            const auto* slot = s_registry.lookup(mv);
+            if (!slot) return false;
+            calls = slot->proxy->calls();
+            routed = slot->proxy->routed();
+            return true;
         }
 
     }  // namespace hooks::gfx_ei
@@ -1,69 +1,43 @@
 #include "core/racemenu_ei_driver.h"
 
+#include "core/arg0_sequence.h"
+#include "core/drive_template.h"
+#include "core/ei_dispatch.h"
+#include "core/ei_event_names.h"
+#include "core/ei_recorder.h"
+#include "core/ei_session.h"
+#include "core/timer_wheel.h"
 #include "logger.h"
 
 namespace MorphFixer {
     namespace {
 
-        using clock_ns = std::chrono::steady_clock;
-        static inline long long now_ns() {
-            return std::chrono::duration_cast<std::chrono::nanoseconds>(clock_ns::now().time_since_epoch()).count();
-        }
-
-        struct ArgCopy {
-            RE::GFxValue::ValueType t{RE::GFxValue::ValueType::kUndefined};
-            double num{0.0};
-            bool b{false};
-            std::string s;
-
-            void toValue(RE::GFxValue& out) const {
-                switch (t) {
-                    case RE::GFxValue::ValueType::kNumber:
-                        out.SetNumber(num);
-                        break;
-                    case RE::GFxValue::ValueType::kBoolean:
-                        out.SetBoolean(b);
-                        break;
-                    case RE::GFxValue::ValueType::kString:
-                        out.SetString(s.c_str());
-                        break;
-                    default:
-                        out.SetUndefined();
-                        break;
-                }
-            }
-            static ArgCopy from(const RE::GFxValue& v) {
-                ArgCopy c;
-                c.t = v.GetType();
-                if (v.IsNumber())
-                    c.num = v.GetNumber();
-                else if (v.GetType() == RE::GFxValue::ValueType::kBoolean)
-                    c.b = v.GetBool();
-                else if (v.IsString())
-                    c.s = v.GetString();
-                return c;
-            }
-        };
+        static ArgSnapshotCell s_snap;
+        static DriveTemplate<RE::GFxValue> s_template;
 
-        struct Snapshot {
-            std::uint32_t argc{0};
-            std::vector<ArgCopy> args;  // arg[1] is normalized weight
-        };
+        // arg0 slots shared with RaceMenu's own calls (native values advance it in observe())
+        static Arg0Sequence s_arg0;
 
-        static std::mutex s_mu;
-        static Snapshot s_snap;
-        static std::atomic_bool s_have{false};
+        // Preset cooldown: generation of the arming call (0 = inactive), cleared by a TimerWheel timer.
+        // The generation lets the expiry lose against a concurrent re-arm instead of clobbering it.
+        static constexpr auto PRESET_COOLDOWN = std::chrono::milliseconds(1500);
+        static std::atomic<std::uint32_t> s_preset_gen{0};
+        static std::atomic<std::uint32_t> s_preset_active{0};
 
-        // Most recent arg0 seen on ANY EI call
-        static std::atomic<double> s_last_any_arg0{0.0};
-        static std::atomic_bool s_have_any_arg0{false};
+        static TimerWheel::TimerId presetTimer();
 
-        // Most recent arg0 seen specifically on ChangeWeight
-        static std::atomic<double> s_last_cw_arg0{0.0};
-        static std::atomic_bool s_have_cw_arg0{false};
+        static void onPresetCooldownElapsed() {
+            auto gen = s_preset_active.load(std::memory_order_relaxed);
+            if (gen == 0 || TimerWheel::get().armed(presetTimer())) return;
+            if (s_preset_active.compare_exchange_strong(gen, 0, std::memory_order_relaxed)) {
+                LOG_DEBUG("[RMF] preset cooldown elapsed");
+            }
+        }
 
-        // Preset cooldown (ns since epoch)
-        static std::atomic<long long> s_preset_until_ns{0};
+        static TimerWheel::TimerId presetTimer() {
+            static const TimerWheel::TimerId id = TimerWheel::get().create(onPresetCooldownElapsed);
+            return id;
+        }
 
         static RE::GFxExternalInterface* getExternalInterfaceAddref(RE::GFxMovieView* mv) {
             if (!mv) return nullptr;
@@ -71,30 +45,6 @@ namespace MorphFixer {
             return reinterpret_cast<RE::GFxExternalInterface*>(st);
         }
 
-        static inline bool containsCaseInsensitive(const char* hay, const char* needle) {
-            if (!hay || !needle) return false;
-            const auto nlen = std::strlen(needle);
-            for (const char* p = hay; *p; ++p) {
-                if (_strnicmp(p, needle, nlen) == 0) return true;
-            }
-            return false;
-        }
-
-        // Next arg0 to use: prefer ANY->+1, else CW->+1, else 0.
-        static inline double nextArg0() {
-            if (s_have_any_arg0.load(std::memory_order_relaxed)) {
-                const auto last = s_last_any_arg0.load(std::memory_order_relaxed);
-                const long long i = static_cast<long long>(std::llround(last));
-                return static_cast<double>(i + 1);
-            }
-            if (s_have_cw_arg0.load(std::memory_order_relaxed)) {
-                const auto last = s_last_cw_arg0.load(std::memory_order_relaxed);
-                const long long i = static_cast<long long>(std::llround(last));
-                return static_cast<double>(i + 1);
-            }
-            return 0.0;
-        }
-
     }  // namespace
 
     namespace Helpers::RaceMenuExternalInterface {
@@ -102,75 +52,37 @@ namespace MorphFixer {
         void recordChangeWeightArguments(const RE::GFxValue* args, std::uint32_t argc) {
             if (!args || argc == 0) return;
 
-            std::lock_guard lk(s_mu);
-
-            s_snap.argc = argc;
-            s_snap.args.resize(argc);
-            for (std::uint32_t i = 0; i < argc; ++i) s_snap.args[i] = ArgCopy::from(args[i]);
-
-            s_have.store(true, std::memory_order_relaxed);
-
-            if (argc >= 1 && args[0].IsNumber()) {
-                const double a0 = args[0].GetNumber();
-                s_last_any_arg0.store(a0, std::memory_order_relaxed);
-                s_have_any_arg0.store(true, std::memory_order_relaxed);
-                s_last_cw_arg0.store(a0, std::memory_order_relaxed);
-                s_have_cw_arg0.store(true, std::memory_order_relaxed);
-            }
+            s_snap.store(args, argc);
         }
 
         bool snapshotLastWeight(double& outNorm) {
-            std::lock_guard lk(s_mu);
-            if (!s_have.load(std::memory_order_relaxed) || s_snap.argc < 2) return false;
-            if (s_snap.args[1].t != RE::GFxValue::ValueType::kNumber) return false;
-            outNorm = std::clamp(s_snap.args[1].num, 0.0, 1.0);
+            ArgSnapshot snap;
+            if (!s_snap.load(snap) || snap.argc < 2) return false;
+            if (snap.args[1].t != ArgCopy::Kind::kNumber) return false;
+            outNorm = std::clamp(snap.args[1].num, 0.0, 1.0);
             return true;
         }
 
         bool driveChangeWeightNormWithArg0(RE::GFxMovieView* mv, double normalized, double arg0) {
             if (!mv) return false;
 
-            std::vector<RE::GFxValue> callArgs;
-            {
-                std::lock_guard lk(s_mu);
-                if (s_have.load(std::memory_order_relaxed)) {
-                    callArgs.resize(s_snap.argc);
-                    for (std::uint32_t i = 0; i < s_snap.argc; ++i) s_snap.args[i].toValue(callArgs[i]);
-
-                    if (s_snap.argc > 1) {
-                        callArgs[1].SetNumber(std::clamp(normalized, 0.0, 1.0));
-                    } else {
-                        callArgs.resize(3);
-                        callArgs[1].SetNumber(std::clamp(normalized, 0.0, 1.0));
-                        callArgs[2].SetNumber(2.0);
-                    }
-                } else {
-                    callArgs.resize(3);
-                    callArgs[1].SetNumber(std::clamp(normalized, 0.0, 1.0));
-                    callArgs[2].SetNumber(2.0);
-                }
+            const auto callArgc = s_template.prepare(s_snap, arg0, normalized);
 
-                if (callArgs.empty()) callArgs.resize(1);
-                callArgs[0].SetNumber(arg0);
-
-                // Stamp trackers with what we're sending
-                s_last_any_arg0.store(arg0, std::memory_order_relaxed);
-                s_have_any_arg0.store(true, std::memory_order_relaxed);
-                s_last_cw_arg0.store(arg0, std::memory_order_relaxed);
-                s_have_cw_arg0.store(true, std::memory_order_relaxed);
-            }
-
-            auto* ei = getExternalInterfaceAddref(mv);
+            // Session-pinned EI (our proxy); the state lookup is only a fallback outside a session.
+            ExternalInterfaceRef fallback;
+            auto* ei = EiSession::get().lookupOr(mv, fallback, getExternalInterfaceAddref);
             if (!ei) return false;
 
-            ei->Callback(mv, "ChangeWeight", callArgs.data(), static_cast<std::uint32_t>(callArgs.size()));
-            ei->Release();
+            {
+                EiRecorder::DriverScope origin;
+                ei->Callback(mv, "ChangeWeight", s_template.args.data(), callArgc);
+            }
             return true;
         }
 
         bool driveChangeWeightNorm(RE::GFxMovieView* mv, double normalized) {
-            const double a0 = nextArg0();
-            return driveChangeWeightNormWithArg0(mv, normalized, a0);
+            const auto a0 = s_arg0.reserve();
+            return driveChangeWeightNormWithArg0(mv, normalized, static_cast<double>(a0));
         }
 
         bool nudgeThenRestoreNorm(RE::GFxMovieView* mv, double normalized, double epsilon) {
@@ -180,43 +92,52 @@ namespace MorphFixer {
             const double norm = std::clamp(normalized, 0.0, 1.0);
             const double nudged = (norm - eps >= 0.0) ? (norm - eps) : std::min(1.0, norm + eps);
 
-            // Fence one slot to avoid colliding with the *very next* native EI call.
-            const double base = nextArg0() + 1.0;
+            // One range for the pair: nothing (native or ours) can land between nudge and restore.
+            const auto base = s_arg0.reserve(2);
 
-            const bool a = driveChangeWeightNormWithArg0(mv, nudged, base);
-            const bool b = driveChangeWeightNormWithArg0(mv, norm, base + 1.0);
+            const bool a = driveChangeWeightNormWithArg0(mv, nudged, static_cast<double>(base));
+            const bool b = driveChangeWeightNormWithArg0(mv, norm, static_cast<double>(base + 1));
 
-            LOG_DEBUG("[RMF] EI nudge+restore: norm={:.3f} -> {:.3f} -> {:.3f} (arg0 {:.0f},{:.0f}) ok={} {}", norm,
-                      nudged, norm, base, base + 1.0, a, b);
+            LOG_DEBUG("[RMF] EI nudge+restore: norm={:.3f} -> {:.3f} -> {:.3f} (arg0 {},{}) ok={} {}", norm, nudged,
+                      norm, base, base + 1, a, b);
             return a && b;
         }
 
-        bool presetCooldownActive() {
-            const auto now = now_ns();
-            const auto until = s_preset_until_ns.load(std::memory_order_relaxed);
-            return until > now;
+        void resetSession() {
+            s_template.invalidate();
+            s_arg0.resetStats();
         }
 
-        void observe(const char* name, const RE::GFxValue* args, std::uint32_t argc) {
-            if (!name) return;
+        Arg0Sequence::Stats arg0Stats() { return s_arg0.stats(); }
+
+        bool presetCooldownActive() { return s_preset_active.load(std::memory_order_relaxed) != 0; }
 
-            // Track arg0 from ANY EI call if numeric
-            if (argc >= 1 && args && args[0].IsNumber()) {
-                s_last_any_arg0.store(args[0].GetNumber(), std::memory_order_relaxed);
-                s_have_any_arg0.store(true, std::memory_order_relaxed);
+        void observe(const EiEvent& ev) {
+            if (!ev.name) return;
+
+            // Native arg0 from ANY EI call advances the sequence; our own drives come back through
+            // the proxy too and must not count against their own reservation.
+            if (const auto a0 = ev.number(0); a0 && !EiRecorder::DriverScope::active()) {
+                if (s_arg0.observe(*a0)) {
+                    LOG_DEBUG("[RMF] arg0 collision: native {} {:.0f} reused a drive slot", ev.name, *a0);
+                }
             }
 
-            if (_stricmp(name, "ChangeWeight") == 0) {
-                recordChangeWeightArguments(args, argc);
+            using Helpers::EventClassifier::EventClass;
+            const auto cls = ev.cls;
+
+            if (cls == EventClass::kWeight) {
+                recordChangeWeightArguments(ev.args, ev.argc);
                 return;
             }
 
             // Any preset-related EI call extends a short cooldown window
-            if (containsCaseInsensitive(name, "Preset")) {
-                constexpr auto ttl = std::chrono::milliseconds(1500);
-                const auto until = now_ns() + std::chrono::duration_cast<std::chrono::nanoseconds>(ttl).count();
-                s_preset_until_ns.store(until, std::memory_order_relaxed);
-                LOG_DEBUG("[RMF] preset cooldown armed ({} ms)", static_cast<int>(ttl.count()));
+            if (Helpers::EventClassifier::isPreset(cls)) {
+                TimerWheel::get().arm(presetTimer(), PRESET_COOLDOWN);
+                auto gen = s_preset_gen.fetch_add(1, std::memory_order_relaxed) + 1;
+                if (gen == 0) gen = s_preset_gen.fetch_add(1, std::memory_order_relaxed) + 1;  // skip 0 on wrap
+                s_preset_active.store(gen, std::memory_order_relaxed);
+                LOG_DEBUG("[RMF] preset cooldown armed ({} ms)", static_cast<int>(PRESET_COOLDOWN.count()));
             }
         }
 
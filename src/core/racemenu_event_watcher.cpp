@@ -44,13 +44,14 @@ namespace MorphFixer {
         // - "RaceMenuSliderChanged"
         // - "OBody_SetMorph" (morph triggers)
         // - "TNGAroused_SetMorph" (morph triggers)
-        // Also catch anything containing "SliderChange"/"Slider"
+        // Also catch anything containing "Slider" (which covers "SliderChange")
         if (name == "RSM_SliderChange"sv || name == "RM_OnSliderChange"sv || name == "RaceMenuSliderChanged"sv ||
             name == "OBody_SetMorph"sv || name == "TNGAroused_SetMorph"sv) {
             return true;
         }
 
-        return name.find("SliderChange"sv) != std::string_view::npos || name.find("Slider"sv) != std::string_view::npos;
+        // Plain find: these names are 12-25 chars, below where the vector search pays off (tools/ascii_check)
+        return name.find("Slider"sv) != std::string_view::npos;
     }
 
     RE::BSEventNotifyControl RaceMenuEventWatcher::ProcessEvent(const SKSE::ModCallbackEvent* a_event,
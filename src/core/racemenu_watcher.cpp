@@ -1,13 +1,42 @@
 #include "core/racemenu_watcher.h"
 
+#include "core/ei_recorder.h"
+#include "core/ei_tracepoint.h"
 #include "core/gfx_ei_hook.h"
+#include "core/racemenu_ei_driver.h"
+#include "features/morph_cache.h"
 #include "features/morph_updater.h"
 #include "helpers/ui.h"
 #include "logger.h"
+#include "settings.h"
 
 namespace MorphFixer {
     using namespace std::literals;
 
+    namespace {
+        // Menus listed in [debug] observe_menus get a proxy that only counts and traces their EI calls
+        bool isObserved(const RE::BSFixedString& name) {
+            for (const auto& m : Settings::get().observe_menus) {
+                if (name == std::string_view{m}) return true;
+            }
+            return false;
+        }
+
+        void observe(const RE::BSFixedString& name, bool opening) {
+            auto ui = RE::UI::GetSingleton();
+            if (!ui) return;
+            auto m = ui->GetMenu(name);
+            auto* mv = m ? m->uiMovie.get() : nullptr;
+            if (!mv) return;
+            if (opening) {
+                LOG_DEBUG("[RaceMenuWatcher] observing '{}'", name.c_str());
+                Hooks::GfxExternalInterface::enable(mv, false);
+            } else {
+                Hooks::GfxExternalInterface::disable(mv);
+            }
+        }
+    }
+
     RaceMenuWatcher& RaceMenuWatcher::get() {
         static RaceMenuWatcher instance;
         return instance;
@@ -21,6 +50,7 @@ namespace MorphFixer {
 
         const auto& name = evn->menuName;
         if (const bool isRM = (name == "RaceSex Menu"sv) || (name == "RaceMenu"sv); !isRM) {
+            if (isObserved(name)) observe(name, evn->opening);
             return RE::BSEventNotifyControl::kContinue;
         }
 
@@ -34,11 +64,16 @@ namespace MorphFixer {
                 if (auto* mv = m->uiMovie.get()) {
                     if (opening) {
                         LOG_DEBUG("[RaceMenuWatcher] RaceMenu opened -> MorphUpdater enabled");
-                        Hooks::GfxExternalInterface::enable(mv);
+                        EiRecorder::get().clear();
+                        Helpers::RaceMenuExternalInterface::resetSession();
+                        Hooks::GfxExternalInterface::enable(mv, true);
                     } else {
                         LOG_DEBUG("[RaceMenuWatcher] RaceMenu closed -> MorphUpdater disabled");
                         Hooks::GfxExternalInterface::disable(mv);
+                        EiTracepoints::drain();  // the session's last calls, before its summary
                         MorphUpdater::get().onMenuClosed();
+                        MorphCache::get().onSafePoint("RaceMenu closed");
+                        EiRecorder::get().dumpSession();
                     }
                 }
             }
@@ -0,0 +1,228 @@
+#include "core/timer_wheel.h"
+
+#include <algorithm>
+#include <bit>
+#include <system_error>
+
+namespace MorphFixer {
+    namespace {
+        constexpr long long NS_PER_TICK = 1'000'000LL;  // 1 ms
+    }
+
+    TimerWheel& TimerWheel::get() {
+        static TimerWheel s;
+        return s;
+    }
+
+    TimerWheel::TimerWheel() : m_epoch_ns(nowNs()) {
+        m_heads.fill(NIL);
+        m_nodes.reserve(MAX_TIMERS);
+        m_fire.reserve(MAX_TIMERS);
+    }
+
+    long long TimerWheel::nowNs() noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    long long TimerWheel::tickOf(long long ns) const noexcept {
+        if (ns <= m_epoch_ns) return 0;
+        return (ns - m_epoch_ns + NS_PER_TICK - 1) / NS_PER_TICK;  // round up: never fire early
+    }
+
+    long long TimerWheel::elapsedTick(long long ns) const noexcept {
+        if (ns <= m_epoch_ns) return 0;
+        return (ns - m_epoch_ns) / NS_PER_TICK;  // only ticks that have fully started
+    }
+
+    long long TimerWheel::nsOf(long long tick) const noexcept { return m_epoch_ns + tick * NS_PER_TICK; }
+
+    TimerWheel::TimerId TimerWheel::create(Callback cb) {
+        std::lock_guard lk(m_mutex);
+        if (m_nodes.size() >= MAX_TIMERS) return INVALID_TIMER;
+        m_nodes.emplace_back().cb = std::move(cb);
+        return static_cast<TimerId>(m_nodes.size() - 1);
+    }
+
+    void TimerWheel::link(std::int32_t id) noexcept {
+        auto& n = m_nodes[id];
+        const long long now = m_now_tick;
+        const long long due = std::max(n.due_tick, now);
+
+        int level = 0;
+        long long index = 0;
+        if (due - now < SLOTS) {
+            index = due & (SLOTS - 1);
+        } else if ((due >> SLOT_BITS) - (now >> SLOT_BITS) < SLOTS) {
+            level = 1;
+            index = (due >> SLOT_BITS) & (SLOTS - 1);
+        } else {
+            // Beyond the wheel range: park in the furthest level-2 slot; it is re-linked when that
+            // slot cascades, so long timers still fire on time (just with extra hops).
+            constexpr int shift = 2 * SLOT_BITS;
+            level = 2;
+            index = (std::min(due >> shift, (now >> shift) + SLOTS - 1)) & (SLOTS - 1);
+        }
+
+        const auto slot = static_cast<std::int32_t>(level * SLOTS + index);
+        n.slot = slot;
+        n.prev = NIL;
+        n.next = m_heads[slot];
+        if (n.next != NIL) m_nodes[n.next].prev = id;
+        m_heads[slot] = id;
+        m_occupied[level] |= (1ULL << index);
+    }
+
+    void TimerWheel::unlink(std::int32_t id) noexcept {
+        auto& n = m_nodes[id];
+        if (n.slot == NIL) return;
+        if (n.prev != NIL) {
+            m_nodes[n.prev].next = n.next;
+        } else {
+            m_heads[n.slot] = n.next;
+        }
+        if (n.next != NIL) m_nodes[n.next].prev = n.prev;
+        if (m_heads[n.slot] == NIL) {
+            m_occupied[n.slot / SLOTS] &= ~(1ULL << (n.slot % SLOTS));
+        }
+        n.prev = n.next = n.slot = NIL;
+    }
+
+    void TimerWheel::cascade(int level, long long tick) noexcept {
+        const auto index = (tick >> (level * SLOT_BITS)) & (SLOTS - 1);
+        const auto slot = static_cast<std::int32_t>(level * SLOTS + index);
+        auto id = m_heads[slot];
+        m_heads[slot] = NIL;
+        m_occupied[level] &= ~(1ULL << index);
+        while (id != NIL) {
+            const auto next = m_nodes[id].next;
+            m_nodes[id].slot = NIL;
+            link(id);  // lands in a lower level now that it is closer
+            id = next;
+        }
+    }
+
+    long long TimerWheel::nextTick() const noexcept {
+        long long best = -1;
+        const auto consider = [&](long long t) { best = (best < 0) ? t : std::min(best, t); };
+
+        // Level 0 holds exact ticks in (now, now + 64]; higher levels only need their cascade tick.
+        for (int level = 0; level < LEVELS; ++level) {
+            const auto bits = m_occupied[level];
+            if (!bits) continue;
+            const int shift = level * SLOT_BITS;
+            const long long cur = (m_now_tick >> shift) + 1;
+            const auto dist = std::countr_zero(std::rotr(bits, static_cast<int>(cur & (SLOTS - 1))));
+            consider((cur + dist) << shift);
+        }
+        return best;
+    }
+
+    void TimerWheel::advanceTo(long long target) noexcept {
+        while (true) {
+            const auto next = nextTick();
+            if (next < 0 || next > target) {
+                m_now_tick = std::max(m_now_tick, target);
+                return;
+            }
+            m_now_tick = next;
+            if ((next & ((1LL << (2 * SLOT_BITS)) - 1)) == 0) cascade(2, next);
+            if ((next & (SLOTS - 1)) == 0) cascade(1, next);
+
+            const auto slot = static_cast<std::int32_t>(next & (SLOTS - 1));
+            while (m_heads[slot] != NIL) {
+                const auto id = m_heads[slot];
+                unlink(id);
+                if (m_nodes[id].due_tick > next) {
+                    link(id);  // parked out-of-range timer, not due yet
+                } else {
+                    m_fire.push_back(id);
+                }
+            }
+        }
+    }
+
+    void TimerWheel::armAt(TimerId id, long long dueNs) noexcept {
+        std::unique_lock lk(m_mutex);
+        if (id >= m_nodes.size()) return;
+
+        const auto i = static_cast<std::int32_t>(id);
+        unlink(i);
+        m_nodes[i].due_tick = std::max(tickOf(dueNs), m_now_tick + 1);
+        link(i);
+
+        ensureThread();
+        // Only interrupt the worker if it sleeps past the new deadline (or is idle).
+        const bool wake = m_wake_tick < 0 || m_nodes[i].due_tick < m_wake_tick;
+        lk.unlock();
+        if (wake) m_cv.notify_one();
+    }
+
+    void TimerWheel::arm(TimerId id, std::chrono::nanoseconds delay) noexcept { armAt(id, nowNs() + delay.count()); }
+
+    void TimerWheel::cancel(TimerId id) noexcept {
+        std::lock_guard lk(m_mutex);
+        if (id >= m_nodes.size()) return;
+        unlink(static_cast<std::int32_t>(id));
+    }
+
+    bool TimerWheel::armed(TimerId id) const noexcept {
+        std::lock_guard lk(m_mutex);
+        return id < m_nodes.size() && m_nodes[id].slot != NIL;
+    }
+
+    void TimerWheel::ensureThread() noexcept {
+        if (m_thread.joinable() || m_stop) return;
+        try {
+            m_thread = std::thread([this] { run(); });
+            m_running = true;
+        } catch (const std::system_error&) {
+            // No worker: timers stay armed but never fire. Owners treat that as "never elapsed".
+        }
+    }
+
+    void TimerWheel::shutdown() noexcept {
+        std::unique_lock lk(m_mutex);
+        m_stop = true;
+        m_cv.notify_all();
+        if (!m_thread.joinable() || m_thread.get_id() == std::this_thread::get_id()) return;
+
+        // Wait for the worker to leave run() (no callback in flight), then let the thread end on its own
+        m_cv.wait_for(lk, SHUTDOWN_WAIT, [this] { return !m_running; });
+        lk.unlock();
+        m_thread.detach();
+    }
+
+    void TimerWheel::run() noexcept {
+        std::unique_lock lk(m_mutex);
+        while (!m_stop) {
+            m_wakeups.fetch_add(1, std::memory_order_relaxed);
+            m_wake_tick = 0;  // awake: arms never need to notify
+            advanceTo(elapsedTick(nowNs()));
+
+            if (!m_fire.empty()) {
+                // Callbacks are immutable after create() and m_fire is worker-only, so run unlocked.
+                lk.unlock();
+                for (const auto id : m_fire) {
+                    if (const auto& cb = m_nodes[id].cb) cb();
+                }
+                lk.lock();
+                m_fire.clear();
+                continue;
+            }
+
+            const auto next = nextTick();
+            if (next < 0) {
+                m_wake_tick = -1;
+                m_cv.wait(lk);
+            } else {
+                m_wake_tick = next;
+                m_cv.wait_until(lk, std::chrono::steady_clock::time_point{std::chrono::nanoseconds{nsOf(next)}});
+            }
+        }
+        m_running = false;
+        m_cv.notify_all();  // shutdown() waits for this
+    }
+
+}  // namespace MorphFixer
@@ -0,0 +1,127 @@
+#include "core/ui_task_channel.h"
+
+#include "helpers/alloc_counter.h"
+
+namespace MorphFixer {
+
+    UiTaskChannel& UiTaskChannel::get() {
+        static UiTaskChannel s;
+        return s;
+    }
+
+    UiTaskChannel::UiTaskChannel() {
+        static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+        for (std::size_t i = 0; i < CAPACITY; ++i) {
+            m_cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // Bounded MPMC ring (sequence-numbered cells): producers are the EI callback and the timer
+    // wheel, the consumer is the UI thread (or the caller itself when SKSE has no task interface).
+    bool UiTaskChannel::push(const Command& cmd) noexcept {
+        auto pos = m_head.load(std::memory_order_relaxed);
+        while (true) {
+            auto& cell = m_cells[pos & (CAPACITY - 1)];
+            const auto seq = cell.seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.cmd = cmd;
+                    cell.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // full
+            } else {
+                pos = m_head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool UiTaskChannel::pop(Command& out) noexcept {
+        auto pos = m_tail.load(std::memory_order_relaxed);
+        while (true) {
+            auto& cell = m_cells[pos & (CAPACITY - 1)];
+            const auto seq = cell.seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    out = cell.cmd;
+                    cell.seq.store(pos + CAPACITY, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // empty
+            } else {
+                pos = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool UiTaskChannel::submit(const Command& cmd) noexcept {
+        const auto allocs = Helpers::Alloc::threadCount();
+        if (!push(cmd)) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        m_submitted.fetch_add(1, std::memory_order_relaxed);
+        const bool pumped = schedulePump();
+        m_submit_allocs.fetch_add(Helpers::Alloc::threadCount() - allocs, std::memory_order_relaxed);
+
+        if (!pumped) {
+            // No task interface: should not happen post-init, but don't crash release
+            m_inline_drains.fetch_add(1, std::memory_order_relaxed);
+            drain();
+        }
+        return true;
+    }
+
+    // False when the caller has to drain itself (no SKSE task interface).
+    bool UiTaskChannel::schedulePump() noexcept {
+        if (m_pump_queued.exchange(true, std::memory_order_acq_rel)) return true;  // a pump is already pending
+
+        auto* ti = SKSE::GetTaskInterface();
+        if (!ti) return false;
+        m_pumps.fetch_add(1, std::memory_order_relaxed);
+        ti->AddUITask(&m_pump);
+        return true;
+    }
+
+    void UiTaskChannel::drain() noexcept {
+        // Clear first: anything submitted after this point queues a fresh pump.
+        m_pump_queued.store(false, std::memory_order_release);
+
+        const auto handler = m_handler.load(std::memory_order_acquire);
+        Command cmd;
+        while (pop(cmd)) {
+            if (!handler) continue;
+            const auto allocs = Helpers::Alloc::threadCount();
+            handler(cmd);
+            m_handler_allocs.fetch_add(Helpers::Alloc::threadCount() - allocs, std::memory_order_relaxed);
+            m_executed.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    UiTaskChannel::Stats UiTaskChannel::stats() const noexcept {
+        Stats s;
+        s.submitted = m_submitted.load(std::memory_order_relaxed);
+        s.dropped = m_dropped.load(std::memory_order_relaxed);
+        s.pumps = m_pumps.load(std::memory_order_relaxed);
+        s.inline_drains = m_inline_drains.load(std::memory_order_relaxed);
+        s.executed = m_executed.load(std::memory_order_relaxed);
+        s.submit_allocs = m_submit_allocs.load(std::memory_order_relaxed);
+        s.handler_allocs = m_handler_allocs.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    void UiTaskChannel::resetStats() noexcept {
+        m_submitted.store(0, std::memory_order_relaxed);
+        m_dropped.store(0, std::memory_order_relaxed);
+        m_pumps.store(0, std::memory_order_relaxed);
+        m_inline_drains.store(0, std::memory_order_relaxed);
+        m_executed.store(0, std::memory_order_relaxed);
+        m_submit_allocs.store(0, std::memory_order_relaxed);
+        m_handler_allocs.store(0, std::memory_order_relaxed);
+    }
+
+}  // namespace MorphFixer
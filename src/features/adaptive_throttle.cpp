@@ -0,0 +1,61 @@
+#include "features/adaptive_throttle.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace MorphFixer {
+    namespace {
+        constexpr double NS_PER_MS = 1'000'000.0;
+
+        int clampMs(double ms, int lo, int hi) noexcept {
+            if (hi < lo) hi = lo;
+            return std::clamp(static_cast<int>(std::lround(ms)), lo, hi);
+        }
+    }
+
+    void AdaptiveThrottle::configure(const Config& cfg) noexcept {
+        m_cfg = cfg;
+        m_cost_ns.store(0.0, std::memory_order_relaxed);
+        m_completion_ns.store(0.0, std::memory_order_relaxed);
+        m_samples.store(0, std::memory_order_relaxed);
+
+        const auto throttle =
+            cfg.enabled ? clampMs(cfg.throttle_ms, cfg.throttle_min_ms, cfg.throttle_max_ms) : cfg.throttle_ms;
+        const auto gap =
+            cfg.enabled ? clampMs(cfg.idle_gap_ms, cfg.idle_gap_min_ms, cfg.idle_gap_max_ms) : cfg.idle_gap_ms;
+        m_throttle_ms.store(std::max(0, throttle), std::memory_order_relaxed);
+        m_idle_gap_ms.store(std::max(0, gap), std::memory_order_relaxed);
+    }
+
+    void AdaptiveThrottle::onDriveCompleted(long long costNs, long long completionNs) noexcept {
+        if (costNs < 0 || completionNs < costNs) return;
+
+        auto cost = static_cast<double>(costNs);
+        auto completion = static_cast<double>(completionNs);
+        const auto samples = m_samples.load(std::memory_order_relaxed);
+        if (samples != 0) {
+            const auto prevCost = m_cost_ns.load(std::memory_order_relaxed);
+            const auto prevCompletion = m_completion_ns.load(std::memory_order_relaxed);
+            cost = prevCost + EWMA_ALPHA * (cost - prevCost);
+            completion = prevCompletion + EWMA_ALPHA * (completion - prevCompletion);
+        }
+        m_cost_ns.store(cost, std::memory_order_relaxed);
+        m_completion_ns.store(completion, std::memory_order_relaxed);
+        m_samples.store(samples + 1, std::memory_order_relaxed);
+
+        if (!m_cfg.enabled) return;
+
+        const double settleMs = completion / NS_PER_MS;
+        m_throttle_ms.store(clampMs(settleMs * THROTTLE_FACTOR, m_cfg.throttle_min_ms, m_cfg.throttle_max_ms),
+                            std::memory_order_relaxed);
+        m_idle_gap_ms.store(clampMs(settleMs * IDLE_GAP_FACTOR, m_cfg.idle_gap_min_ms, m_cfg.idle_gap_max_ms),
+                            std::memory_order_relaxed);
+    }
+
+    AdaptiveThrottle::Summary AdaptiveThrottle::summary() const noexcept {
+        return {throttleMs(), idleGapMs(), m_samples.load(std::memory_order_relaxed),
+                m_cost_ns.load(std::memory_order_relaxed) / NS_PER_MS,
+                m_completion_ns.load(std::memory_order_relaxed) / NS_PER_MS};
+    }
+
+}  // namespace MorphFixer
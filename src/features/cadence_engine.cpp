@@ -0,0 +1,348 @@
+#include "features/cadence_engine.h"
+
+#include <algorithm>
+
+#include "helpers/consts.h"
+
+namespace MorphFixer {
+    namespace {
+        inline double clamp01(double x) { return x < 0 ? 0 : (x > 1 ? 1 : x); }
+
+        inline bool validNorm(double x) { return x >= 0.0 && x <= 1.0; }
+    }
+
+    double CadenceEngine::resolveBaseline(double hint) noexcept {
+        if (validNorm(hint)) return hint;
+        const double cur = m_baseline_norm.load(std::memory_order_relaxed);
+        return validNorm(cur) ? cur : clamp01(m_weights.currentNorm());
+    }
+
+    void CadenceEngine::applyNudge(double baseline) noexcept {
+        // Use session baseline (prevents drift across taps)
+        baseline = resolveBaseline(baseline);
+
+        // At 0.0, nudge UP by +1% instead of down
+        const bool nudgeUp = (baseline <= 0.0);
+        const double target = clamp01(baseline + (nudgeUp ? +NUDGE_EPSILON : -NUDGE_EPSILON));
+
+        m_driver.drive(target);
+        m_drives.fetch_add(1, std::memory_order_relaxed);
+        m_last_was_nudge.store(true, std::memory_order_relaxed);
+        m_nudge_ns = m_clock.nowNs();
+        m_last_applied_ns.store(m_nudge_ns, std::memory_order_relaxed);
+    }
+
+    void CadenceEngine::applyRestore(double baseline) noexcept {
+        // Restore to session baseline
+        m_driver.drive(resolveBaseline(baseline));
+        m_drives.fetch_add(1, std::memory_order_relaxed);
+        m_last_was_nudge.store(false, std::memory_order_relaxed);
+        const auto now = m_clock.nowNs();
+        if (m_nudge_ns >= 0) {
+            m_latency.nudgeToRestore.recordSigned(now - m_nudge_ns);
+            m_nudge_ns = -1;
+        }
+        m_last_applied_ns.store(now, std::memory_order_relaxed);
+    }
+
+    void CadenceEngine::applyNudgeRestore(double baseline) noexcept {
+        // Use session baseline to keep nudge+restore symmetric and drift-free
+        m_driver.nudgeRestore(resolveBaseline(baseline), NUDGE_EPSILON);
+        m_drives.fetch_add(2, std::memory_order_relaxed);
+        m_last_was_nudge.store(false, std::memory_order_relaxed);
+        m_last_applied_ns.store(m_clock.nowNs(), std::memory_order_relaxed);
+    }
+
+    void CadenceEngine::applyRefresh() noexcept {
+        m_dirty.store(false, std::memory_order_relaxed);
+        m_driver.refresh();
+        m_refreshes.fetch_add(1, std::memory_order_relaxed);
+        m_last_applied_ns.store(m_clock.nowNs(), std::memory_order_relaxed);
+    }
+
+    bool CadenceEngine::useSkee() noexcept {
+        return m_mode.load(std::memory_order_relaxed) == RefreshMode::kSkee && m_driver.canRefresh();
+    }
+
+    bool CadenceEngine::morphsUnchanged() noexcept {
+        if (!m_skip_unchanged.load(std::memory_order_relaxed) || m_driver.morphsChanged()) return false;
+        m_dirty.store(false, std::memory_order_relaxed);  // nothing left to refresh
+        m_skipped.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    CadenceEngine::EventResult CadenceEngine::onEvent(std::string_view name,
+                                                      std::optional<double> weightNorm) noexcept {
+        if (!m_enabled.load(std::memory_order_relaxed)) return EventResult::kDisabled;
+        return onEvent(Helpers::EventNames::resolve(name), weightNorm);
+    }
+
+    CadenceEngine::EventResult CadenceEngine::onEvent(Helpers::EventNames::EventInfo ev,
+                                                      std::optional<double> weightNorm) noexcept {
+        if (!m_enabled.load(std::memory_order_relaxed)) return EventResult::kDisabled;
+
+        using Helpers::EventClassifier::EventClass;
+        const auto [id, cls] = ev;
+
+        // --- SPECIAL: ChangeWeight carries the live weight value ---
+        if (cls == EventClass::kWeight) {
+            // Only record origin when NOT in an update session
+            if (weightNorm && !m_session_active.load(std::memory_order_relaxed)) {
+                m_baseline_norm.store(clamp01(*weightNorm), std::memory_order_relaxed);
+            }
+            return EventResult::kBaseline;  // never treat ChangeWeight itself as a slider-change trigger
+        }
+
+        // only "Change*" slider-ish events; preset events count when they are Change* ones
+        if (cls != EventClass::kSlider && cls != EventClass::kPresetChange) return EventResult::kIgnored;
+
+        m_received.fetch_add(1, std::memory_order_relaxed);
+        m_dirty.store(true, std::memory_order_relaxed);
+
+        const auto now = m_clock.nowNs();
+        const long long thrNs = static_cast<long long>(std::max(0, m_cadence.throttleMs())) * Helpers::Consts::NS_PER_MS;
+
+        auto last = m_last_applied_ns.load(std::memory_order_relaxed);
+        const bool nameChanged = (m_last_event_id.load(std::memory_order_relaxed) != id);
+        bool okToApplyNow = nameChanged || last < 0 || (now - last) >= thrNs;
+
+        // Claim the slot by stamping the apply time: concurrent producers for the same window lose the CAS.
+        if (okToApplyNow) {
+            okToApplyNow = m_last_applied_ns.compare_exchange_strong(last, now, std::memory_order_relaxed);
+        }
+
+        auto result = EventResult::kThrottled;
+        if (okToApplyNow) {
+            m_last_event_id.store(id, std::memory_order_relaxed);
+
+            // --- START SESSION ---
+            if (!m_session_active.exchange(true, std::memory_order_relaxed)) {
+                m_sessions.fetch_add(1, std::memory_order_relaxed);
+                // If baseline wasn't filled by a prior ChangeWeight, fall back to a snapshot now.
+                if (!validNorm(m_baseline_norm.load(std::memory_order_relaxed))) {
+                    m_baseline_norm.store(clamp01(m_weights.currentNorm()), std::memory_order_relaxed);
+                }
+            }
+
+            // Latest wins: a task already queued for this frame picks the new id up when it runs.
+            m_pending_event_id.store(id, std::memory_order_release);
+            if (m_ui_tasks_outstanding.fetch_add(1, std::memory_order_acq_rel) < MAX_UI_TASKS) {
+                UiCommand cmd;
+                cmd.op = UiOp::kSlider;
+                cmd.eventId = id;
+                cmd.baseline = m_baseline_norm.load(std::memory_order_relaxed);
+                cmd.postedNs = now;
+                if (submit(cmd)) {
+                    result = EventResult::kPosted;
+                } else {
+                    m_ui_tasks_outstanding.fetch_sub(1, std::memory_order_acq_rel);
+                }
+            } else {
+                m_ui_tasks_outstanding.fetch_sub(1, std::memory_order_acq_rel);
+                m_merged.fetch_add(1, std::memory_order_relaxed);
+                result = EventResult::kMerged;
+            }
+        } else {
+            m_throttled.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Always schedule the "last" cleanup tick
+        armTail(now + thrNs);
+        return result;
+    }
+
+    bool CadenceEngine::submit(const UiCommand& cmd) noexcept {
+        if (!m_sink.submit(cmd)) return false;
+        m_latency.queueDepth.record(m_sink.depth());
+        return true;
+    }
+
+    void CadenceEngine::armTail(long long dueNs) noexcept {
+        // Pushing the deadline later (drag storm) is a single store: the armed timer re-reads
+        // m_tail_due_ns when it fires and re-arms itself. Only arming from idle, or an earlier
+        // deadline, reaches the sink.
+        const auto prev = m_tail_due_ns.exchange(dueNs, std::memory_order_relaxed);
+        if (prev <= 0 || dueNs < prev) {
+            m_sink.armTail(dueNs);
+        }
+    }
+
+    void CadenceEngine::onTailTimer() noexcept {
+        // CAS loop: onEvent may move the deadline while we decide.
+        while (true) {
+            const auto due = m_tail_due_ns.load(std::memory_order_relaxed);
+            if (due <= 0) return;
+
+            auto expected = due;
+            if (!m_enabled.load(std::memory_order_relaxed)) {
+                if (m_tail_due_ns.compare_exchange_weak(expected, -1, std::memory_order_relaxed)) return;
+                continue;
+            }
+
+            const auto now = m_clock.nowNs();
+            if (now < due) {
+                m_sink.armTail(due);  // re-armed later while we were pending
+                return;
+            }
+
+            // Only flush if we've been idle a bit (adaptive idle gap, 150 ms by default)
+            const auto last = m_last_applied_ns.load(std::memory_order_relaxed);
+            const long long minGapNs = static_cast<long long>(m_cadence.idleGapMs()) * Helpers::Consts::NS_PER_MS;
+            if (last >= 0 && (now - last) < minGapNs) {
+                // Not enough idle gap yet; push due forward so the tail runs an idle gap after the last apply
+                const long long newDue = last + minGapNs;
+                if (m_tail_due_ns.compare_exchange_weak(expected, newDue, std::memory_order_relaxed)) {
+                    m_sink.armTail(newDue);
+                    return;
+                }
+                continue;
+            }
+
+            // disarm before executing tail
+            if (m_tail_due_ns.compare_exchange_weak(expected, -1, std::memory_order_relaxed)) {
+                m_latency.tailDelay.recordSigned(now - due);
+                break;
+            }
+        }
+
+        UiCommand cmd;
+        cmd.op = UiOp::kTail;
+        cmd.flag = m_last_was_nudge.load(std::memory_order_relaxed);
+        cmd.baseline = m_baseline_norm.load(std::memory_order_relaxed);
+        cmd.postedNs = m_clock.nowNs();
+        submit(cmd);
+    }
+
+    void CadenceEngine::runTask(const UiCommand& cmd) noexcept {
+        switch (cmd.op) {
+            case UiOp::kSlider:
+                runSlider(cmd);
+                break;
+            case UiOp::kTail:
+                runTail(cmd);
+                break;
+            case UiOp::kSettle:
+                runSettle(cmd);
+                break;
+        }
+    }
+
+    void CadenceEngine::runSlider(const UiCommand& cmd) noexcept {
+        // Release our slot before draining: an event landing in between either gets drained here
+        // or queues the next frame's task (which then finds an empty mailbox). Nothing is stranded.
+        m_ui_tasks_outstanding.fetch_sub(1, std::memory_order_acq_rel);
+        const auto id = m_pending_event_id.exchange(Helpers::EventNames::NO_EVENT, std::memory_order_acq_rel);
+        if (id == Helpers::EventNames::NO_EVENT) return;
+        if (!m_driver.ready()) return;
+
+        const auto t0 = m_clock.nowNs();
+        m_latency.eventToTask.recordSigned(t0 - cmd.postedNs);
+        // Face sliders, colour pickers etc. are Change* events too; they leave body morphs alone.
+        // An outstanding nudge is always restored.
+        if (!m_last_was_nudge.load(std::memory_order_relaxed) && morphsUnchanged()) return;
+
+        if (useSkee()) {
+            // One pass, no weight oscillation; undo a nudge left over from a mode switch first
+            if (m_last_was_nudge.load(std::memory_order_relaxed)) applyRestore(cmd.baseline);
+            applyRefresh();
+        } else if (!m_last_was_nudge.load(std::memory_order_relaxed)) {
+            applyNudge(cmd.baseline);
+        } else {
+            applyRestore(cmd.baseline);
+        }
+        const auto t1 = m_clock.nowNs();
+        m_latency.taskToDrive.recordSigned(t1 - t0);
+        settle(t0, cmd.postedNs);
+        m_executed.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void CadenceEngine::runTail(const UiCommand& cmd) noexcept {
+        if (!m_driver.ready()) return;
+
+        const auto t0 = m_clock.nowNs();
+        bool applied = true;
+        if (useSkee()) {
+            if (cmd.flag) applyRestore(cmd.baseline);
+            // Only throttled events are still unrefreshed; a drag whose last event ran needs nothing
+            if (m_dirty.load(std::memory_order_relaxed) && !morphsUnchanged()) {
+                applyRefresh();
+            } else {
+                applied = cmd.flag;
+            }
+        } else if (cmd.flag) {
+            applyRestore(cmd.baseline);  // finish from nudge → restore-only
+        } else if (!morphsUnchanged()) {
+            applyNudgeRestore(cmd.baseline);  // single-tap / balanced finish
+        } else {
+            applied = false;
+        }
+        if (applied) {
+            // Skipped tails cost nothing and would drag the adaptive cadence down
+            const auto t1 = m_clock.nowNs();
+            m_latency.taskToDrive.recordSigned(t1 - t0);
+            settle(t0, cmd.postedNs);
+        }
+        m_tails.fetch_add(1, std::memory_order_relaxed);
+
+        // --- END SESSION ---
+        m_session_active.store(false, std::memory_order_relaxed);
+        m_last_was_nudge.store(false, std::memory_order_relaxed);
+    }
+
+    void CadenceEngine::settle(long long driveNs, long long postedNs) noexcept {
+        // The drive only queued the model update; the cadence has to wait for the rebuild itself
+        UiCommand cmd;
+        cmd.op = UiOp::kSettle;
+        cmd.postedNs = postedNs;
+        cmd.driveNs = driveNs;
+        m_sink.submitSettle(cmd);
+    }
+
+    void CadenceEngine::runSettle(const UiCommand& cmd) noexcept {
+        const auto now = m_clock.nowNs();
+        m_latency.driveToSettle.recordSigned(now - cmd.driveNs);
+        m_cadence.onDriveCompleted(now - cmd.driveNs, now - cmd.postedNs);
+    }
+
+    void CadenceEngine::reset() noexcept {
+        m_last_event_id.store(Helpers::EventNames::NO_EVENT);
+        m_last_applied_ns.store(-1);
+        m_tail_due_ns.store(-1);
+        m_last_was_nudge.store(false);
+        m_dirty.store(false);
+        m_nudge_ns = -1;
+        // End any in-progress session and clear baseline
+        m_session_active.store(false);
+        m_baseline_norm.store(-1.0);
+        m_pending_event_id.store(Helpers::EventNames::NO_EVENT);
+        m_sink.cancelTail();
+    }
+
+    CadenceEngine::Stats CadenceEngine::stats() const noexcept {
+        return {m_received.load(std::memory_order_relaxed), m_throttled.load(std::memory_order_relaxed),
+                m_merged.load(std::memory_order_relaxed),   m_executed.load(std::memory_order_relaxed),
+                m_drives.load(std::memory_order_relaxed),   m_refreshes.load(std::memory_order_relaxed),
+                m_tails.load(std::memory_order_relaxed),    m_sessions.load(std::memory_order_relaxed),
+                m_skipped.load(std::memory_order_relaxed)};
+    }
+
+    void CadenceEngine::resetStats() noexcept {
+        m_received.store(0);
+        m_throttled.store(0);
+        m_merged.store(0);
+        m_executed.store(0);
+        m_drives.store(0);
+        m_refreshes.store(0);
+        m_tails.store(0);
+        m_sessions.store(0);
+        m_skipped.store(0);
+
+        m_latency.eventToTask.reset();
+        m_latency.taskToDrive.reset();
+        m_latency.driveToSettle.reset();
+        m_latency.nudgeToRestore.reset();
+        m_latency.tailDelay.reset();
+        m_latency.queueDepth.reset();
+    }
+
+}  // namespace MorphFixer
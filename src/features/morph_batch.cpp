@@ -0,0 +1,64 @@
+#include "features/morph_batch.h"
+
+#include <algorithm>
+
+#include "skee.h"
+
+namespace MorphFixer {
+
+    MorphBatch& MorphBatch::set(RE::TESObjectREFR* actor, std::string_view name, std::string_view key, float value) {
+        push(actor, name, key, value, false);
+        return *this;
+    }
+
+    MorphBatch& MorphBatch::clear(RE::TESObjectREFR* actor, std::string_view name, std::string_view key) {
+        push(actor, name, key, 0.0f, true);
+        return *this;
+    }
+
+    void MorphBatch::push(RE::TESObjectREFR* actor, std::string_view name, std::string_view key, float value,
+                          bool clear) {
+        if (!actor || name.empty()) return;
+        m_ops.push_back({actor, m_strings.intern(name), m_strings.intern(key), static_cast<std::uint32_t>(m_ops.size()),
+                         value, clear});
+    }
+
+    MorphBatch::Result MorphBatch::apply(SKEE::IBodyMorphInterface& bmi) {
+        Result r;
+        if (m_ops.empty()) return r;
+
+        // Group by actor, then key; within a key the newest op sorts first and is the one kept
+        std::sort(m_ops.begin(), m_ops.end(), [](const Op& a, const Op& b) {
+            if (a.actor != b.actor) return std::less<>{}(a.actor, b.actor);
+            if (a.name != b.name) return a.name < b.name;
+            if (a.key != b.key) return a.key < b.key;
+            return a.seq > b.seq;
+        });
+
+        for (std::size_t i = 0; i < m_ops.size();) {
+            auto* actor = m_ops[i].actor;
+            for (; i < m_ops.size() && m_ops[i].actor == actor; ++i) {
+                const auto& op = m_ops[i];
+                if (i > 0 && m_ops[i - 1].actor == actor && m_ops[i - 1].name == op.name &&
+                    m_ops[i - 1].key == op.key) {
+                    ++r.superseded;
+                    continue;
+                }
+                if (op.clear) {
+                    bmi.ClearMorph(actor, m_strings.c_str(op.name), m_strings.c_str(op.key));
+                    ++r.clears;
+                } else {
+                    bmi.SetMorph(actor, m_strings.c_str(op.name), m_strings.c_str(op.key), op.value);
+                    ++r.sets;
+                }
+            }
+            bmi.ApplyBodyMorphs(actor, true);
+            bmi.UpdateModelWeight(actor, true);
+            ++r.actors;
+        }
+
+        m_ops.clear();
+        return r;
+    }
+
+}  // namespace MorphFixer
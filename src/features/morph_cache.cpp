@@ -0,0 +1,96 @@
+#include "features/morph_cache.h"
+
+#include "helpers/process_memory.h"
+#include "logger.h"
+#include "pch.h"
+#include "skee.h"
+
+namespace MorphFixer {
+    namespace {
+        constexpr double MB = 1024.0 * 1024.0;
+
+        inline double toMb(std::uint64_t bytes) { return static_cast<double>(bytes) / MB; }
+
+        constexpr const char* pressureName(MorphCachePolicy::Pressure p) {
+            switch (p) {
+                case MorphCachePolicy::Pressure::kLow:
+                    return "low";
+                case MorphCachePolicy::Pressure::kElevated:
+                    return "elevated";
+                case MorphCachePolicy::Pressure::kHigh:
+                    return "high";
+            }
+            return "?";
+        }
+    }
+
+    MorphCache& MorphCache::get() {
+        static MorphCache s;
+        return s;
+    }
+
+    void MorphCache::configure(const MorphCachePolicy::Config& cfg) {
+        auto& wheel = TimerWheel::get();
+        if (m_timer == TimerWheel::INVALID_TIMER) {
+            m_timer = wheel.create([this] { poll(); });
+        }
+        wheel.cancel(m_timer);
+
+        MorphCachePolicy policy;
+        policy.configure(cfg);
+        m_policy.store(policy);
+        m_enabled.store(cfg.enabled);
+        if (!cfg.enabled) {
+            LOG_INFO("[MorphCache] disabled; SKEE cache limit left at its default");
+            return;
+        }
+
+        const auto& c = policy.config();
+        LOG_INFO("[MorphCache] limit {}..{} MB, water marks {}/{} MB, poll {} ms", c.limit_min_mb, c.limit_max_mb,
+                 c.low_water_mb, c.high_water_mb, c.poll_ms);
+        m_limit.store(0);  // re-send on the first poll
+        wheel.arm(m_timer, std::chrono::milliseconds(0));
+    }
+
+    void MorphCache::poll() noexcept {
+        MorphCachePolicy policy;
+        if (!m_enabled.load() || !m_policy.load(policy)) return;
+        TimerWheel::get().arm(m_timer, std::chrono::milliseconds(policy.config().poll_ms));
+
+        const auto used = Helpers::Process::privateBytes();
+        if (!used || !m_bmi.load()) return;
+
+        const auto limit = policy.limitFor(used);
+        if (m_limit.exchange(limit) == limit) return;
+
+        LOG_DEBUG("[MorphCache] process {:.0f} MB ({} pressure) -> cache limit {:.0f} MB", toMb(used),
+                  pressureName(policy.pressureFor(used)), toMb(limit));
+        // SKEE's cache is owned by the main thread
+        if (auto* task = SKSE::GetTaskInterface()) {
+            task->AddTask([this, limit] {
+                if (auto* bmi = m_bmi.load()) bmi->SetCacheLimit(static_cast<std::size_t>(limit));
+            });
+        }
+    }
+
+    void MorphCache::onSafePoint(std::string_view reason) noexcept {
+        auto* bmi = m_bmi.load();
+        MorphCachePolicy policy;
+        if (!bmi || !m_enabled.load() || !m_policy.load(policy)) return;
+
+        const auto before = Helpers::Process::privateBytes();
+        if (!policy.clearAtSafePoint(before)) {
+            LOG_DEBUG("[MorphCache] {}: process {:.0f} MB below low water, cache kept", reason, toMb(before));
+            return;
+        }
+
+        const auto t0 = TimerWheel::nowNs();
+        const auto reclaimed = bmi->ClearMorphCache();
+        const auto ms = static_cast<double>(TimerWheel::nowNs() - t0) / 1e6;
+        const auto after = Helpers::Process::privateBytes();
+
+        LOG_INFO("[MorphCache] {}: cleared {:.1f} MB in {:.2f} ms (process {:.0f} -> {:.0f} MB, {} pressure)", reason,
+                 toMb(reclaimed), ms, toMb(before), toMb(after), pressureName(policy.pressureFor(before)));
+    }
+
+}  // namespace MorphFixer
@@ -0,0 +1,41 @@
+#include "features/morph_cache_policy.h"
+
+#include <algorithm>
+
+namespace MorphFixer {
+    namespace {
+        constexpr std::uint64_t MB = 1ull << 20;
+    }
+
+    void MorphCachePolicy::configure(const Config& cfg) noexcept {
+        m_cfg = cfg;
+        m_cfg.limit_min_mb = std::max(0, cfg.limit_min_mb);
+        m_cfg.limit_max_mb = std::max(m_cfg.limit_min_mb, cfg.limit_max_mb);
+        m_cfg.low_water_mb = std::max(0, cfg.low_water_mb);
+        m_cfg.high_water_mb = std::max(m_cfg.low_water_mb + 1, cfg.high_water_mb);
+        m_cfg.poll_ms = std::max(1000, cfg.poll_ms);
+    }
+
+    MorphCachePolicy::Pressure MorphCachePolicy::pressureFor(std::uint64_t processBytes) const noexcept {
+        if (processBytes >= static_cast<std::uint64_t>(m_cfg.high_water_mb) * MB) return Pressure::kHigh;
+        if (processBytes >= static_cast<std::uint64_t>(m_cfg.low_water_mb) * MB) return Pressure::kElevated;
+        return Pressure::kLow;
+    }
+
+    std::uint64_t MorphCachePolicy::limitFor(std::uint64_t processBytes) const noexcept {
+        const auto lo = static_cast<std::uint64_t>(m_cfg.low_water_mb) * MB;
+        const auto hi = static_cast<std::uint64_t>(m_cfg.high_water_mb) * MB;
+        const auto minLimit = static_cast<std::uint64_t>(m_cfg.limit_min_mb) * MB;
+        const auto maxLimit = static_cast<std::uint64_t>(m_cfg.limit_max_mb) * MB;
+
+        std::uint64_t limit = maxLimit;
+        if (processBytes >= hi) {
+            limit = minLimit;
+        } else if (processBytes > lo) {
+            const double t = static_cast<double>(processBytes - lo) / static_cast<double>(hi - lo);
+            limit = maxLimit - static_cast<std::uint64_t>(t * static_cast<double>(maxLimit - minLimit));
+        }
+        return std::max(minLimit, limit / LIMIT_STEP_BYTES * LIMIT_STEP_BYTES);
+    }
+
+}  // namespace MorphFixer
@@ -0,0 +1,64 @@
+#include "features/morph_snapshot.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "helpers/float_diff.h"
+
+namespace MorphFixer {
+
+    void MorphSnapshot::clear() noexcept {
+        m_names.clear();
+        m_keys.clear();
+        m_values.clear();
+    }
+
+    void MorphSnapshot::add(Id name, Id key, float value) {
+        m_names.push_back(name);
+        m_keys.push_back(key);
+        m_values.push_back(value);
+    }
+
+    void MorphSnapshot::finish() {
+        const auto n = m_values.size();
+
+        // (name, key) is unique per actor, so the packed pair alone orders the rows
+        m_sort.resize(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            m_sort[i] = (static_cast<std::uint64_t>(m_names[i]) << 32) | m_keys[i];
+        }
+        if (std::is_sorted(m_sort.begin(), m_sort.end())) return;  // SKEE usually visits in a stable order
+
+        m_order.resize(n);
+        for (std::uint32_t i = 0; i < n; ++i) m_order[i] = i;
+        std::sort(m_order.begin(), m_order.end(),
+                  [&](std::uint32_t a, std::uint32_t b) { return m_sort[a] < m_sort[b]; });
+
+        m_tmp.resize(n);
+        for (std::size_t i = 0; i < n; ++i) m_tmp[i] = m_values[m_order[i]];
+        m_values.swap(m_tmp);
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto k = m_sort[m_order[i]];
+            m_names[i] = static_cast<Id>(k >> 32);
+            m_keys[i] = static_cast<Id>(k & 0xFFFFFFFFu);
+        }
+    }
+
+    bool MorphSnapshot::sameRows(const MorphSnapshot& o) const noexcept {
+        const auto n = m_values.size();
+        if (n != o.m_values.size()) return false;
+        if (n == 0) return true;
+        return std::memcmp(m_names.data(), o.m_names.data(), n * sizeof(Id)) == 0 &&
+               std::memcmp(m_keys.data(), o.m_keys.data(), n * sizeof(Id)) == 0;
+    }
+
+    bool MorphSnapshot::sameAs(const MorphSnapshot& o, float tolerance) const noexcept {
+        return sameRows(o) && !Helpers::FloatDiff::any(m_values, o.m_values, tolerance);
+    }
+
+    std::size_t MorphSnapshot::changedRows(const MorphSnapshot& o, float tolerance,
+                                           std::vector<std::uint32_t>& out) const {
+        return Helpers::FloatDiff::changed(m_values, o.m_values, tolerance, out);
+    }
+
+}  // namespace MorphFixer
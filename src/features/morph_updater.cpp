@@ -1,6 +1,9 @@
 #include "features/morph_updater.h"
 
+#include "core/ei_dispatch.h"
 #include "core/racemenu_ei_driver.h"
+#include "core/ui_task_channel.h"
+#include "helpers/alloc_counter.h"
 #include "helpers/consts.h"
 #include "helpers/ui.h"
 #include "logger.h"
@@ -17,19 +20,47 @@ namespace MorphFixer {
                        std::chrono::steady_clock::now().time_since_epoch())
                 .count();
         }
-        inline bool contains(std::string_view s, std::string_view needle) {
-            return s.find(needle) != std::string_view::npos;
+        inline double toMs(std::uint64_t ns) { return static_cast<double>(ns) / Helpers::Consts::NS_PER_MS; }
+
+        void logLatency(std::string_view what, const Helpers::LogLinearHistogram& h) {
+            const auto s = h.summary();
+            if (s.count == 0) return;
+            LOG_INFO("[MorphUpdater] latency {}: n={} p50={:.2f} ms p99={:.2f} ms max={:.2f} ms", what, s.count,
+                     toMs(s.p50), toMs(s.p99), toMs(s.max));
         }
-        inline double clamp01(double x) { return x < 0 ? 0 : (x > 1 ? 1 : x); }
 
-        inline void post_ui(std::function<void()> fn) {
-            if (auto* ti = SKSE::GetTaskInterface(); ti) {
-                ti->AddUITask(std::move(fn));
-            } else {
-                // Should not happen post-init, but don't crash release
-                fn();
+        // Fills a MorphSnapshot from IBodyMorphInterface::VisitMorphValues
+        struct SnapshotVisitor final : SKEE::IBodyMorphInterface::MorphValueVisitor {
+            SnapshotVisitor(MorphStringIds& ids, MorphSnapshot& out) : m_ids(ids), m_out(out) {}
+
+            void Visit(RE::TESObjectREFR*, const char* name, const char* key, float value) override {
+                if (!name || !key) return;
+                m_out.add(m_ids.intern(name), m_ids.intern(key), value);
             }
-        }
+
+            MorphStringIds& m_ids;
+            MorphSnapshot& m_out;
+        };
+
+        // Bulk-interns SKEE's string table (every morph name and key it knows) in two passes:
+        // count/size first so the pool reserves once, then intern.
+        struct SeedVisitor final : SKEE::IBodyMorphInterface::StringVisitor {
+            void Visit(const char* s) override {
+                if (!s) return;
+                if (m_pool) {
+                    m_pool->intern(s);
+                } else {
+                    ++m_count;
+                    m_chars += std::strlen(s);
+                }
+            }
+
+            MorphStringIds* m_pool{nullptr};
+            std::size_t m_count{0};
+            std::size_t m_chars{0};
+        };
+
+        inline double clamp01(double x) { return x < 0 ? 0 : (x > 1 ? 1 : x); }
 
         inline double read_current_norm_baseline() {
             double norm = 0.5;
@@ -49,227 +80,277 @@ namespace MorphFixer {
         return s;
     }
 
-    void MorphUpdater::setMorphInterface(SKEE::IBodyMorphInterface* bmi) noexcept {
-        m_skee_bmi = bmi;
-        if (!m_skee_bmi) {
-            LOG_WARN("[SKEE] BodyMorph interface missing");
-            return;
-        }
-        LOG_INFO("[SKEE] BodyMorph wired into MorphUpdater.");
+    MorphUpdater::MorphUpdater() {
+        UiTaskChannel::get().setHandler([](const UiTaskChannel::Command& cmd) noexcept {
+            auto& self = MorphUpdater::get();
+            self.m_engine.runTask(cmd);
+            if (cmd.op == UiTaskChannel::Op::kTail && !self.m_engine.sessionActive()) {
+                LOG_DEBUG("[MorphUpdater] Session end;");
+            }
+        });
     }
 
-    void MorphUpdater::updateModelWeight(RE::TESObjectREFR* refr) noexcept {
-        if (!refr) return;
-        if (auto* a = refr->As<RE::Actor>()) {
-            a->DoReset3D(true);
+    // --- CadenceEngine wiring ---
+
+    long long MorphUpdater::SteadyClock::nowNs() const noexcept { return now_ns(); }
+
+    bool MorphUpdater::ChannelSink::submit(const UiCommand& cmd) noexcept {
+        if (UiTaskChannel::get().submit(cmd)) return true;
+        if (cmd.op == UiOp::kTail) {
+            LOG_WARN("[MorphUpdater] UI task channel full; tail flush dropped");
         }
+        return false;
     }
 
-    RE::GFxMovieView* MorphUpdater::currentRaceMenuMovie() noexcept {
-        if (auto* ui = RE::UI::GetSingleton(); ui) {
-            if (ui->IsMenuOpen("RaceSex Menu"sv) || ui->IsMenuOpen("RaceMenu"sv)) {
-                auto m = ui->GetMenu("RaceSex Menu"sv);
-                if (!m) m = ui->GetMenu("RaceMenu"sv);
-                if (m && m->uiMovie) return m->uiMovie.get();
-            }
+    bool MorphUpdater::ChannelSink::submitSettle(const UiCommand& cmd) noexcept {
+        auto* ti = SKSE::GetTaskInterface();
+        if (!ti) return false;
+        for (auto& t : m_settles) {
+            if (t.busy.exchange(true, std::memory_order_acquire)) continue;
+            t.cmd = cmd;
+            ti->AddTask(&t);
+            return true;
         }
-        return nullptr;
+        return false;
     }
 
-    bool MorphUpdater::isRaceMenuOpen() noexcept {
-        if (auto* ui = RE::UI::GetSingleton(); ui)
-            return ui->IsMenuOpen("RaceSex Menu"sv) || ui->IsMenuOpen("RaceMenu"sv);
-        return false;
+    void MorphUpdater::ChannelSink::ensureTimer() noexcept {
+        if (m_timer.load(std::memory_order_acquire) != TimerWheel::INVALID_TIMER) return;
+
+        static std::once_flag once;
+        std::call_once(once, [this] {
+            const auto id = TimerWheel::get().create([] { MorphUpdater::get().m_engine.onTailTimer(); });
+            if (id == TimerWheel::INVALID_TIMER) {
+                LOG_ERROR("[MorphUpdater] timer wheel full; tail flush disabled");
+            }
+            m_timer.store(id, std::memory_order_release);
+        });
     }
 
-    void MorphUpdater::applyNudge(RE::GFxMovieView* mv) noexcept {
-        if (!mv) return;
-        auto* player = RE::PlayerCharacter::GetSingleton();
-        if (!player) return;
+    void MorphUpdater::ChannelSink::armTail(long long dueNs) noexcept {
+        ensureTimer();
+        TimerWheel::get().armAt(m_timer.load(std::memory_order_acquire), dueNs);
+    }
 
-        // Use session baseline (prevents drift across taps)
-        double baseline = m_LastBaselineNorm.load(std::memory_order_relaxed);
-        if (baseline < 0.0 || baseline > 1.0) {
-            baseline = read_current_norm_baseline();
-        }
+    void MorphUpdater::ChannelSink::cancelTail() noexcept {
+        TimerWheel::get().cancel(m_timer.load(std::memory_order_acquire));
+    }
 
-        // At 0.0, nudge UP by +1% instead of down
-        const double eps = 0.01;
-        const bool nudgeUp = (baseline <= 0.0);
-        const double target = clamp01(baseline + (nudgeUp ? +eps : -eps));
+    std::size_t MorphUpdater::ChannelSink::depth() const noexcept { return UiTaskChannel::get().depth(); }
 
-        const bool ok = Helpers::RaceMenuExternalInterface::driveChangeWeightNorm(mv, target);
-        LOG_DEBUG("[MorphUpdater] EI ChangeWeight(nudge-only {}1%) -> {}", nudgeUp ? "+" : "-", ok);
+    double MorphUpdater::LiveWeight::currentNorm() noexcept { return read_current_norm_baseline(); }
 
-        m_LastWasNudge.store(true, std::memory_order_relaxed);
-        m_LastAppliedNs.store(now_ns(), std::memory_order_relaxed);
+    bool MorphUpdater::MenuDriver::ready() noexcept {
+        m_movie = isRaceMenuOpen() ? currentRaceMenuMovie() : nullptr;
+        return m_movie != nullptr;
     }
 
-    void MorphUpdater::applyRestore(RE::GFxMovieView* mv) noexcept {
-        if (!mv) return;
-        // Restore to session baseline
-        double baseline = m_LastBaselineNorm.load(std::memory_order_relaxed);
-        if (baseline < 0.0 || baseline > 1.0) {
-            baseline = read_current_norm_baseline();
-        }
-        const bool ok = Helpers::RaceMenuExternalInterface::driveChangeWeightNorm(mv, baseline);
-        LOG_DEBUG("[MorphUpdater] EI ChangeWeight(restore-only) -> {}", ok);
-        m_LastWasNudge.store(false, std::memory_order_relaxed);
-        m_LastAppliedNs.store(now_ns(), std::memory_order_relaxed);
+    bool MorphUpdater::MenuDriver::drive(double norm) noexcept {
+        const bool ok = Helpers::RaceMenuExternalInterface::driveChangeWeightNorm(m_movie, norm);
+        LOG_DEBUG("[MorphUpdater] EI ChangeWeight({:.3f}) -> {}", norm, ok);
+        return ok;
     }
 
-    void MorphUpdater::applyNudgeRestore(RE::GFxMovieView* mv) noexcept {
-        if (!mv) return;
-        // Use session baseline to keep nudge+restore symmetric and drift-free
-        double baseline = m_LastBaselineNorm.load(std::memory_order_relaxed);
-        if (baseline < 0.0 || baseline > 1.0) {
-            baseline = read_current_norm_baseline();
-        }
-        const bool ok = Helpers::RaceMenuExternalInterface::nudgeThenRestoreNorm(mv, baseline, 0.01);
-        LOG_DEBUG("[MorphUpdater] EI ChangeWeight(nudge±1% final) -> {}", ok);
-        m_LastWasNudge.store(false, std::memory_order_relaxed);
-        m_LastAppliedNs.store(now_ns(), std::memory_order_relaxed);
+    bool MorphUpdater::MenuDriver::nudgeRestore(double norm, double epsilon) noexcept {
+        const bool ok = Helpers::RaceMenuExternalInterface::nudgeThenRestoreNorm(m_movie, norm, epsilon);
+        LOG_DEBUG("[MorphUpdater] EI ChangeWeight(nudge±{:.0f}% final) -> {}", epsilon * 100.0, ok);
+        return ok;
     }
 
-    void MorphUpdater::ensureTimerThread() noexcept {
-        bool expected = false;
-        if (!m_TimerThreadRunning.compare_exchange_strong(expected, true)) return;
-
-        std::thread([this] {
-            LOG_TRACE("[MorphUpdater] timer thread started");
-            while (true) {
-                if (!m_enabled.load(std::memory_order_relaxed)) {
-                    std::this_thread::sleep_for(10ms);
-                    continue;
-                }
+    bool MorphUpdater::MenuDriver::canRefresh() noexcept { return m_bmi.load(std::memory_order_acquire) != nullptr; }
 
-                const auto due = m_LastWillApplyNs.load(std::memory_order_relaxed);
-                if (due > 0) {
-                    const auto now = now_ns();
-                    if (now >= due) {
-                        // Only flush if we’ve been idle a bit (150 ms)
-                        const auto last = m_LastAppliedNs.load(std::memory_order_relaxed);
-                        const long long minGapNs = 150LL * 1'000'000LL;
-                        if (last < 0 || (now - last) >= minGapNs) {
-                            const bool wasNudge = m_LastWasNudge.load(std::memory_order_relaxed);
-                            post_ui([this, wasNudge] {
-                                if (auto* mv = currentRaceMenuMovie(); mv && isRaceMenuOpen()) {
-                                    LOG_DEBUG("[MorphUpdater] ChangeWeight Operation (tail) for: <idle>");
-                                    if (wasNudge) {
-                                        applyRestore(mv);  // finish from nudge → restore-only
-                                    } else {
-                                        applyNudgeRestore(mv);  // single-tap / balanced finish
-                                    }
-                                    // --- END SESSION ---
-                                    m_SessionActive.store(false, std::memory_order_relaxed);
-                                    m_LastWasNudge.store(false, std::memory_order_relaxed);
-                                    LOG_DEBUG("[MorphUpdater] Session end;");
-                                }
-                            });
-                            // disarm after executing tail
-                            m_LastWillApplyNs.store(-1, std::memory_order_relaxed);
-                        } else {
-                            // Not enough idle gap yet; push due forward to guarantee tail will run ~150ms after last
-                            // apply
-                            const long long newDue = last + minGapNs;
-                            m_LastWillApplyNs.store(newDue, std::memory_order_relaxed);
-                        }
-                    } else {
-                        const auto remain = due - now;
-                        const auto ms = std::max<long long>(1, remain / 1'000'000LL);
-                        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
-                        continue;
-                    }
-                }
+    bool MorphUpdater::MenuDriver::refresh() noexcept {
+        auto* bmi = m_bmi.load(std::memory_order_acquire);
+        auto* player = RE::PlayerCharacter::GetSingleton();
+        if (!bmi || !player) return false;
 
-                std::this_thread::sleep_for(5ms);
-            }
-        }).detach();
+        // Re-apply the current morph set with the update deferred, then a single model update.
+        bmi->ApplyBodyMorphs(player, true);
+        bmi->UpdateModelWeight(player, true);
+        LOG_DEBUG("[MorphUpdater] SKEE refresh");
+        return true;
     }
 
-    void MorphUpdater::onGfxEvent(const char* nameC, const RE::GFxValue* args, std::uint32_t argc) noexcept {
-        if (!m_enabled.load(std::memory_order_relaxed)) return;
-        if (!nameC) return;
-
-        std::string_view name{nameC};
+    void MorphUpdater::MenuDriver::seedMorphIds(SKEE::IBodyMorphInterface& bmi) {
+        SeedVisitor seed;
+        bmi.VisitStrings(seed);
+        const auto before = m_morph_ids.size();
+        m_morph_ids.reserve(before + seed.m_count, seed.m_chars);
+        seed.m_pool = &m_morph_ids;
+        bmi.VisitStrings(seed);
+        m_ids_seeded = true;
+        LOG_DEBUG("[MorphUpdater] morph string pool: {} strings (+{}), {} KiB", m_morph_ids.size(),
+                  m_morph_ids.size() - before, m_morph_ids.memoryBytes() / 1024);
+    }
 
-        // Step 1: store arg0 (for diagnostics / future routing)
-        if (argc >= 1 && args && args[0].IsNumber()) {
-            m_LastAnyArg0.store(args[0].GetNumber(), std::memory_order_relaxed);
+    bool MorphUpdater::MenuDriver::morphsChanged() noexcept {
+        auto* bmi = m_bmi.load(std::memory_order_acquire);
+        auto* player = RE::PlayerCharacter::GetSingleton();
+        if (!bmi || !player) return true;
+
+        try {
+            if (!m_ids_seeded) seedMorphIds(*bmi);
+            m_current.clear();
+            SnapshotVisitor visitor{m_morph_ids, m_current};
+            bmi->VisitMorphValues(player, visitor);
+            m_current.finish();
+        } catch (const std::exception& e) {
+            LOG_WARN("[MorphUpdater] morph snapshot failed: {}", e.what());
+            m_have_applied = false;
+            return true;
         }
 
-        // --- SPECIAL: ChangeWeight carries the live weight value ---
-        if (name == "ChangeWeight"sv) {
-            // arg1 is the normalized value in logs; guard against bad argc/types
-            if (argc >= 2 && args && args[1].IsNumber()) {
-                const double norm = clamp01(args[1].GetNumber());
-                // Only record origin when NOT in an update session
-                if (!m_SessionActive.load(std::memory_order_relaxed)) {
-                    m_LastBaselineNorm.store(norm, std::memory_order_relaxed);
-                    LOG_DEBUG("[MorphUpdater] primed baseline from ChangeWeight (no session): norm={:.3f}", norm);
+        if (m_have_applied) {
+            if (m_current.sameAs(m_applied, MORPH_TOLERANCE)) return false;
+            if (m_current.sameRows(m_applied)) {
+                m_changed.clear();
+                m_current.changedRows(m_applied, MORPH_TOLERANCE, m_changed);
+                if (!m_changed.empty()) {
+                    LOG_DEBUG("[MorphUpdater] {} of {} morph values changed (first: {}/{})", m_changed.size(),
+                              m_current.size(), m_morph_ids.nameOf(m_current.names()[m_changed.front()]),
+                              m_morph_ids.nameOf(m_current.keys()[m_changed.front()]));
                 }
             }
-            return;  // never treat ChangeWeight itself as a slider-change trigger
         }
 
-        // Steps 2–3: only "Change*" slider-ish events
-        if (!contains(name, "Change"sv)) return;
+        // About to be refreshed: this becomes the applied set
+        std::swap(m_current, m_applied);
+        m_have_applied = true;
+        return true;
+    }
+
+    // --- MorphUpdater ---
 
-        // Step 4: blacklist events we won't treat as slider changes (ChangeWeight handled above)
-        if (name == "ChangeRace"sv || name == "ChangeSex"sv || name == "ChangeMenuOpen"sv ||
-            name == "ChangeMenuClose"sv) {
+    void MorphUpdater::setMorphInterface(SKEE::IBodyMorphInterface* bmi) noexcept {
+        m_skee_bmi = bmi;
+        m_driver.m_bmi.store(bmi, std::memory_order_release);
+        if (!m_skee_bmi) {
+            LOG_WARN("[SKEE] BodyMorph interface missing");
             return;
         }
+        LOG_INFO("[SKEE] BodyMorph wired into MorphUpdater.");
+    }
+
+    void MorphUpdater::setCadenceConfig(const AdaptiveThrottle::Config& cfg) noexcept {
+        m_engine.configure(cfg);
+        LOG_INFO("[MorphUpdater] cadence: throttle={} ms, idle gap={} ms (adaptive={})",
+                 m_engine.cadence().throttleMs(), m_engine.cadence().idleGapMs(), cfg.enabled);
+    }
 
-        // Step 5: cadence
-        static std::mutex mu;
-        std::lock_guard lk(mu);
+    void MorphUpdater::setRefreshMode(CadenceEngine::RefreshMode mode) noexcept {
+        m_engine.setRefreshMode(mode);
+        const bool skee = mode == CadenceEngine::RefreshMode::kSkee;
+        LOG_INFO("[MorphUpdater] refresh mode: {}", skee ? "skee" : "nudge");
+        if (skee && !m_driver.canRefresh()) {
+            LOG_WARN("[MorphUpdater] SKEE refresh requested but BodyMorph is not wired yet; using nudge until it is");
+        }
+    }
 
-        if (!isRaceMenuOpen()) {
-            return;
+    void MorphUpdater::setSkipUnchanged(bool on) noexcept {
+        m_engine.setSkipUnchanged(on);
+        LOG_INFO("[MorphUpdater] skip refreshes when morphs are unchanged: {}", on);
+        if (on && !m_driver.canRefresh()) {
+            LOG_WARN("[MorphUpdater] BodyMorph is not wired yet; every refresh runs until it is");
         }
+    }
 
-        const bool nameChanged = (m_LastEventName != name);
-        const auto now = now_ns();
-        const int thr = std::max(0, m_throttle_ms.load(std::memory_order_relaxed));
-        const long long thrNs = static_cast<long long>(thr) * 1'000'000LL;
-
-        const auto last = m_LastAppliedNs.load(std::memory_order_relaxed);
-        const bool okToApplyNow = nameChanged || last < 0 || (now - last) >= thrNs;
-
-        if (okToApplyNow) {
-            // --- START SESSION  ---
-            bool wasActive = m_SessionActive.exchange(true, std::memory_order_relaxed);
-            if (!wasActive) {
-                // If baseline wasn't filled by a prior ChangeWeight, fall back to a snapshot now.
-                double cur = m_LastBaselineNorm.load(std::memory_order_relaxed);
-                if (cur < 0.0 || cur > 1.0) {
-                    cur = read_current_norm_baseline();
-                    m_LastBaselineNorm.store(cur, std::memory_order_relaxed);
-                    LOG_DEBUG("[MorphUpdater] Session start; baseline snapshot: norm={:.3f}", cur);
-                } else {
-                    LOG_DEBUG("[MorphUpdater] Session start; baseline already primed: norm={:.3f}", cur);
-                }
+    void MorphUpdater::updateModelWeight(RE::TESObjectREFR* refr) noexcept {
+        if (!refr) return;
+        if (auto* a = refr->As<RE::Actor>()) {
+            a->DoReset3D(true);
+        }
+    }
+
+    void MorphUpdater::onMenuClosed() noexcept {
+        m_engine.reset();
+        m_driver.resetMorphs();
+
+        const auto st = m_engine.stats();
+        LOG_INFO("[MorphUpdater] slider events: received={} throttled={} merged={} executed={} (sessions={} "
+                 "drives={} skee refreshes={} tails={} skipped unchanged={})",
+                 st.received, st.throttled, st.merged, st.executed, st.sessions, st.drives, st.refreshes, st.tails,
+                 st.skipped);
+        const auto& lat = m_engine.latency();
+        logLatency("event->task"sv, lat.eventToTask);
+        logLatency("task->drive"sv, lat.taskToDrive);
+        logLatency("drive->settle"sv, lat.driveToSettle);
+        logLatency("nudge->restore"sv, lat.nudgeToRestore);
+        logLatency("tail delay"sv, lat.tailDelay);
+        if (const auto qd = lat.queueDepth.summary(); qd.count) {
+            LOG_INFO("[MorphUpdater] ui queue depth: n={} p50={} p99={} max={}", qd.count, qd.p50, qd.p99, qd.max);
+        }
+        m_engine.resetStats();
+
+        const auto cad = m_engine.cadence().summary();
+        LOG_INFO("[MorphUpdater] cadence: throttle={} ms, idle gap={} ms (samples={}, avg cost={:.2f} ms, avg "
+                 "completion={:.2f} ms)",
+                 cad.throttle_ms, cad.idle_gap_ms, cad.samples, cad.avg_cost_ms, cad.avg_completion_ms);
+
+        const auto ch = UiTaskChannel::get().stats();
+        if constexpr (Helpers::Alloc::COUNTING) {
+            LOG_INFO("[MorphUpdater] ui channel: submitted={} dropped={} pumps={} inline={} executed={} (heap allocs: "
+                     "submit={} handlers={})",
+                     ch.submitted, ch.dropped, ch.pumps, ch.inline_drains, ch.executed, ch.submit_allocs,
+                     ch.handler_allocs);
+        } else {
+            LOG_INFO("[MorphUpdater] ui channel: submitted={} dropped={} pumps={} inline={} executed={}", ch.submitted,
+                     ch.dropped, ch.pumps, ch.inline_drains, ch.executed);
+        }
+        UiTaskChannel::get().resetStats();
+
+        const auto seq = Helpers::RaceMenuExternalInterface::arg0Stats();
+        LOG_INFO("[MorphUpdater] arg0 sequence: reserved={} native={} collisions={} next={}", seq.reserved,
+                 seq.observed, seq.collisions, seq.next);
+    }
+
+    MorphUpdater::CoalesceStats MorphUpdater::coalesceStats() const noexcept {
+        const auto st = m_engine.stats();
+        return {st.received, st.throttled, st.merged, st.executed};
+    }
+
+    RE::GFxMovieView* MorphUpdater::currentRaceMenuMovie() noexcept {
+        if (auto* ui = RE::UI::GetSingleton(); ui) {
+            if (ui->IsMenuOpen("RaceSex Menu"sv) || ui->IsMenuOpen("RaceMenu"sv)) {
+                auto m = ui->GetMenu("RaceSex Menu"sv);
+                if (!m) m = ui->GetMenu("RaceMenu"sv);
+                if (m && m->uiMovie) return m->uiMovie.get();
             }
+        }
+        return nullptr;
+    }
 
-            const bool doNudge = !m_LastWasNudge.load(std::memory_order_relaxed);
-            std::string src(name);
-            post_ui([this, doNudge, src = std::move(src)] {
-                if (auto* mv = currentRaceMenuMovie(); mv && isRaceMenuOpen()) {
-                    LOG_DEBUG("[MorphUpdater] ChangeWeight Operation applied for: {} event", src);
-                    if (doNudge) {
-                        applyNudge(mv);
-                    } else {
-                        applyRestore(mv);
-                    }
+    bool MorphUpdater::isRaceMenuOpen() noexcept {
+        if (auto* ui = RE::UI::GetSingleton(); ui)
+            return ui->IsMenuOpen("RaceSex Menu"sv) || ui->IsMenuOpen("RaceMenu"sv);
+        return false;
+    }
+
+    void MorphUpdater::onGfxEvent(const EiEvent& ev) noexcept {
+        if (!m_engine.enabled()) return;
+        if (!ev.name) return;
+        const char* nameC = ev.name;
+
+        // ChangeWeight: arg1 is the normalized value (pre-decoded; absent when not numeric)
+        const auto weightNorm = ev.number(1);
+
+        const bool hadSession = m_engine.sessionActive();
+        using Result = CadenceEngine::EventResult;
+        switch (m_engine.onEvent({ev.id, ev.cls}, weightNorm)) {
+            case Result::kBaseline:
+                if (weightNorm && !hadSession) {
+                    LOG_DEBUG("[MorphUpdater] primed baseline from ChangeWeight (no session): norm={:.3f}",
+                              m_engine.baselineNorm());
+                }
+                break;
+            case Result::kPosted:
+            case Result::kMerged:
+                if (!hadSession && m_engine.sessionActive()) {
+                    LOG_DEBUG("[MorphUpdater] Session start ({}); baseline norm={:.3f}", nameC,
+                              m_engine.baselineNorm());
                 }
-            });
-            m_LastEventName.assign(name.data(), name.size());
+                break;
+            default:
+                break;
         }
-
-        // Always schedule the "last" cleanup tick
-        const long long due = now + (static_cast<long long>(thr) * Helpers::Consts::NS_PER_MS);
-        m_LastWillApplyNs.store(due, std::memory_order_relaxed);
-        ensureTimerThread();
     }
 }  // namespace MorphFixer
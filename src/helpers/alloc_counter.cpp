@@ -0,0 +1,42 @@
+#include "helpers/alloc_counter.h"
+
+#if RMF_COUNT_ALLOCS
+
+#include <cstdlib>
+#include <new>
+
+namespace MorphFixer {
+    namespace {
+        thread_local std::uint64_t t_allocations = 0;  // trivial: no TLS constructor, safe in operator new
+    }
+
+    namespace Helpers::Alloc {
+
+        std::uint64_t threadCount() noexcept { return t_allocations; }
+
+    }
+}  // namespace MorphFixer
+
+// Replaces the plugin's scalar operator new/delete; the array and nothrow forms forward here. The
+// aligned forms keep the default and go uncounted (nothing on the UI path over-aligns).
+void* operator new(std::size_t size) {
+    ++MorphFixer::t_allocations;
+    if (size == 0) size = 1;
+    while (true) {
+        if (void* p = std::malloc(size)) return p;
+        const auto handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+#else
+
+namespace MorphFixer::Helpers::Alloc {
+    std::uint64_t threadCount() noexcept { return 0; }
+}
+
+#endif  // RMF_COUNT_ALLOCS
@@ -0,0 +1,157 @@
+#include "helpers/ascii.h"
+
+#include <bit>
+#include <cstdint>
+
+#include "helpers/cpu_features.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+    #define RMF_SIMD_X86 1
+    #include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define RMF_SIMD_NEON 1
+    #include <arm_neon.h>
+#endif
+
+#if RMF_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+    #define RMF_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+    #define RMF_TARGET_AVX2
+#endif
+
+namespace MorphFixer {
+    namespace {
+        using Helpers::Ascii::findIgnoreCaseScalar;
+        using Helpers::Ascii::toLower;
+        constexpr auto npos = std::string_view::npos;
+
+        using FindFn = std::size_t (*)(std::string_view, std::string_view) noexcept;
+
+        // Candidate positions come from comparing the folded first and last needle bytes against
+        // the folded haystack at i and i+m-1, one vector of positions at a time; each hit is then
+        // confirmed on the middle bytes. Positions the vector loop can't cover go to the scalar tail.
+        inline bool middleMatches(const char* at, std::string_view needle) noexcept {
+            for (std::size_t k = 1; k + 1 < needle.size(); ++k) {
+                if (toLower(at[k]) != toLower(needle[k])) return false;
+            }
+            return true;
+        }
+
+#if RMF_SIMD_X86
+        inline __m128i fold16(__m128i v) noexcept {
+            // 'A'..'Z' -> signed range [-128, -103] after the shift, then OR in 0x20
+            const __m128i shifted = _mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(128 - 'A')));
+            const __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(static_cast<char>(-128 + 26)), shifted);
+            return _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+        }
+
+        std::size_t findSse2(std::string_view hay, std::string_view needle) noexcept {
+            const std::size_t n = hay.size(), m = needle.size();
+            const __m128i first = _mm_set1_epi8(toLower(needle.front()));
+            const __m128i last = _mm_set1_epi8(toLower(needle.back()));
+
+            std::size_t i = 0;
+            for (; i + m - 1 + 16 <= n; i += 16) {
+                const __m128i a = fold16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hay.data() + i)));
+                const __m128i b = fold16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hay.data() + i + m - 1)));
+                auto mask = static_cast<unsigned>(
+                    _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last))));
+                while (mask) {
+                    const auto bit = static_cast<std::size_t>(std::countr_zero(mask));
+                    if (middleMatches(hay.data() + i + bit, needle)) return i + bit;
+                    mask &= mask - 1;
+                }
+            }
+            const auto rest = findIgnoreCaseScalar(hay.substr(i), needle);
+            return rest == npos ? npos : i + rest;
+        }
+
+        RMF_TARGET_AVX2 inline __m256i fold32(__m256i v) noexcept {
+            const __m256i shifted = _mm256_add_epi8(v, _mm256_set1_epi8(static_cast<char>(128 - 'A')));
+            const __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(-128 + 26)), shifted);
+            return _mm256_or_si256(v, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+        }
+
+        RMF_TARGET_AVX2 std::size_t findAvx2(std::string_view hay, std::string_view needle) noexcept {
+            const std::size_t n = hay.size(), m = needle.size();
+            const __m256i first = _mm256_set1_epi8(toLower(needle.front()));
+            const __m256i last = _mm256_set1_epi8(toLower(needle.back()));
+
+            std::size_t i = 0;
+            for (; i + m - 1 + 32 <= n; i += 32) {
+                const __m256i a = fold32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay.data() + i)));
+                const __m256i b =
+                    fold32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay.data() + i + m - 1)));
+                auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+                    _mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last))));
+                while (mask) {
+                    const auto bit = static_cast<std::size_t>(std::countr_zero(mask));
+                    if (middleMatches(hay.data() + i + bit, needle)) return i + bit;
+                    mask &= mask - 1;
+                }
+            }
+            // Up to 31 positions left: let SSE2 take what it can
+            const auto rest = findSse2(hay.substr(i), needle);
+            return rest == npos ? npos : i + rest;
+        }
+
+        FindFn selectFind() noexcept { return Helpers::Cpu::hasAvx2() ? findAvx2 : findSse2; }
+
+#elif RMF_SIMD_NEON
+        inline uint8x16_t fold16(uint8x16_t v) noexcept {
+            const uint8x16_t upper = vcltq_u8(vsubq_u8(v, vdupq_n_u8('A')), vdupq_n_u8(26));
+            return vorrq_u8(v, vandq_u8(upper, vdupq_n_u8(0x20)));
+        }
+
+        std::size_t findNeon(std::string_view hay, std::string_view needle) noexcept {
+            const std::size_t n = hay.size(), m = needle.size();
+            const uint8x16_t first = vdupq_n_u8(static_cast<std::uint8_t>(toLower(needle.front())));
+            const uint8x16_t last = vdupq_n_u8(static_cast<std::uint8_t>(toLower(needle.back())));
+
+            std::size_t i = 0;
+            for (; i + m - 1 + 16 <= n; i += 16) {
+                const auto* p = reinterpret_cast<const std::uint8_t*>(hay.data() + i);
+                const uint8x16_t eq =
+                    vandq_u8(vceqq_u8(fold16(vld1q_u8(p)), first), vceqq_u8(fold16(vld1q_u8(p + m - 1)), last));
+                // 4 bits per lane: narrow the 16 x 8-bit mask into one 64-bit word
+                auto mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+                while (mask) {
+                    const auto bit = static_cast<std::size_t>(std::countr_zero(mask)) / 4;
+                    if (middleMatches(hay.data() + i + bit, needle)) return i + bit;
+                    mask &= ~(0xFull << (bit * 4));
+                }
+            }
+            const auto rest = findIgnoreCaseScalar(hay.substr(i), needle);
+            return rest == npos ? npos : i + rest;
+        }
+
+        FindFn selectFind() noexcept { return findNeon; }
+
+#else
+        FindFn selectFind() noexcept { return findIgnoreCaseScalar; }
+#endif
+    }
+
+    namespace Helpers::Ascii {
+
+        std::size_t findIgnoreCaseScalar(std::string_view hay, std::string_view needle) noexcept {
+            if (needle.empty()) return 0;
+            if (needle.size() > hay.size()) return npos;
+
+            const char first = toLower(needle.front());
+            for (std::size_t i = 0; i + needle.size() <= hay.size(); ++i) {
+                if (toLower(hay[i]) != first) continue;
+                if (equalsIgnoreCase(hay.substr(i, needle.size()), needle)) return i;
+            }
+            return npos;
+        }
+
+        std::size_t findIgnoreCase(std::string_view hay, std::string_view needle) noexcept {
+            if (needle.empty()) return 0;
+            if (needle.size() > hay.size()) return npos;
+            static const FindFn s_find = selectFind();
+            return s_find(hay, needle);
+        }
+
+    }
+}  // namespace MorphFixer
@@ -0,0 +1,65 @@
+#include "helpers/cpu_features.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+    #define RMF_X86_64 1
+    #if defined(_MSC_VER)
+        #include <immintrin.h>
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#endif
+
+namespace MorphFixer {
+    namespace {
+#if RMF_X86_64
+        void cpuid(int leaf, int sub, unsigned (&regs)[4]) noexcept {
+    #if defined(_MSC_VER)
+            int r[4];
+            __cpuidex(r, leaf, sub);
+            for (int i = 0; i < 4; ++i) regs[i] = static_cast<unsigned>(r[i]);
+    #else
+            __cpuid_count(leaf, sub, regs[0], regs[1], regs[2], regs[3]);
+    #endif
+        }
+
+        unsigned long long xgetbv0() noexcept {
+    #if defined(_MSC_VER)
+            return _xgetbv(0);
+    #else
+            unsigned lo = 0, hi = 0;
+            __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+            return (static_cast<unsigned long long>(hi) << 32) | lo;
+    #endif
+        }
+
+        bool detectAvx2() noexcept {
+            unsigned r[4]{};
+            cpuid(0, 0, r);
+            if (r[0] < 7) return false;
+
+            cpuid(1, 0, r);
+            const bool osxsave = (r[2] >> 27) & 1;
+            const bool avx = (r[2] >> 28) & 1;
+            if (!osxsave || !avx) return false;
+            if ((xgetbv0() & 0x6) != 0x6) return false;  // OS saves XMM and YMM state
+
+            cpuid(7, 0, r);
+            return (r[1] >> 5) & 1;
+        }
+#endif
+    }
+
+    namespace Helpers::Cpu {
+
+        bool hasAvx2() noexcept {
+#if RMF_X86_64
+            static const bool s_avx2 = detectAvx2();
+            return s_avx2;
+#else
+            return false;
+#endif
+        }
+
+    }
+}  // namespace MorphFixer
@@ -0,0 +1,181 @@
+#include "helpers/float_diff.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include "helpers/cpu_features.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+    #define RMF_SIMD_X86 1
+    #include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define RMF_SIMD_NEON 1
+    #include <arm_neon.h>
+#endif
+
+#if RMF_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+    #define RMF_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+    #define RMF_TARGET_AVX2
+#endif
+
+namespace MorphFixer {
+    namespace {
+        using Span = std::span<const float>;
+
+        // Kernels compare [from, n) and return the first changed index (n when none), or append
+        // every changed index. The vector loops leave the last partial block to the scalar tail.
+        using AnyFn = std::size_t (*)(const float*, const float*, std::size_t, std::size_t, float) noexcept;
+        using ChangedFn = void (*)(const float*, const float*, std::size_t, std::size_t, float,
+                                   std::vector<std::uint32_t>&);
+
+        inline bool differs(float a, float b, float tol) noexcept { return !(std::fabs(a - b) <= tol); }
+
+        std::size_t firstScalar(const float* a, const float* b, std::size_t from, std::size_t n, float tol) noexcept {
+            for (auto i = from; i < n; ++i) {
+                if (differs(a[i], b[i], tol)) return i;
+            }
+            return n;
+        }
+
+        void changedScalarRange(const float* a, const float* b, std::size_t from, std::size_t n, float tol,
+                                std::vector<std::uint32_t>& out) {
+            for (auto i = from; i < n; ++i) {
+                if (differs(a[i], b[i], tol)) out.push_back(static_cast<std::uint32_t>(i));
+            }
+        }
+
+        inline void appendMask(unsigned mask, std::size_t base, std::vector<std::uint32_t>& out) {
+            while (mask) {
+                out.push_back(static_cast<std::uint32_t>(base + std::countr_zero(mask)));
+                mask &= mask - 1;
+            }
+        }
+
+#if RMF_SIMD_X86
+        // |a-b| > tol or unordered: NLE is true for NaN
+        inline unsigned mask4(const float* a, const float* b, __m128 tol, __m128 absMask) noexcept {
+            const __m128 d = _mm_and_ps(_mm_sub_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)), absMask);
+            return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpnle_ps(d, tol)));
+        }
+
+        std::size_t firstSse2(const float* a, const float* b, std::size_t from, std::size_t n, float t) noexcept {
+            const __m128 tol = _mm_set1_ps(t);
+            const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+            auto i = from;
+            for (; i + 4 <= n; i += 4) {
+                if (const auto m = mask4(a + i, b + i, tol, absMask)) return i + std::countr_zero(m);
+            }
+            return firstScalar(a, b, i, n, t);
+        }
+
+        void changedSse2(const float* a, const float* b, std::size_t from, std::size_t n, float t,
+                         std::vector<std::uint32_t>& out) {
+            const __m128 tol = _mm_set1_ps(t);
+            const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+            auto i = from;
+            for (; i + 4 <= n; i += 4) appendMask(mask4(a + i, b + i, tol, absMask), i, out);
+            changedScalarRange(a, b, i, n, t, out);
+        }
+
+        RMF_TARGET_AVX2 inline unsigned mask8(const float* a, const float* b, __m256 tol, __m256 absMask) noexcept {
+            const __m256 d = _mm256_and_ps(_mm256_sub_ps(_mm256_loadu_ps(a), _mm256_loadu_ps(b)), absMask);
+            return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(d, tol, _CMP_NLE_UQ)));
+        }
+
+        RMF_TARGET_AVX2 std::size_t firstAvx2(const float* a, const float* b, std::size_t from, std::size_t n,
+                                              float t) noexcept {
+            const __m256 tol = _mm256_set1_ps(t);
+            const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+            auto i = from;
+            // 32 floats per step: one branch per four vectors
+            for (; i + 32 <= n; i += 32) {
+                const auto m = mask8(a + i, b + i, tol, absMask) | (mask8(a + i + 8, b + i + 8, tol, absMask) << 8) |
+                               (mask8(a + i + 16, b + i + 16, tol, absMask) << 16) |
+                               (mask8(a + i + 24, b + i + 24, tol, absMask) << 24);
+                if (m) return i + std::countr_zero(m);
+            }
+            for (; i + 8 <= n; i += 8) {
+                if (const auto m = mask8(a + i, b + i, tol, absMask)) return i + std::countr_zero(m);
+            }
+            // Scalar, not SSE2: legacy-SSE code right after 256-bit ops pays a state transition
+            return firstScalar(a, b, i, n, t);
+        }
+
+        RMF_TARGET_AVX2 void changedAvx2(const float* a, const float* b, std::size_t from, std::size_t n, float t,
+                                         std::vector<std::uint32_t>& out) {
+            const __m256 tol = _mm256_set1_ps(t);
+            const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+            auto i = from;
+            for (; i + 8 <= n; i += 8) appendMask(mask8(a + i, b + i, tol, absMask), i, out);
+            changedScalarRange(a, b, i, n, t, out);
+        }
+
+        AnyFn selectFirst() noexcept { return Helpers::Cpu::hasAvx2() ? firstAvx2 : firstSse2; }
+        ChangedFn selectChanged() noexcept { return Helpers::Cpu::hasAvx2() ? changedAvx2 : changedSse2; }
+
+#elif RMF_SIMD_NEON
+        // Lane mask as 4 bits (one per float) via a narrowing shift
+        inline unsigned mask4(const float* a, const float* b, float32x4_t tol) noexcept {
+            const float32x4_t d = vabsq_f32(vsubq_f32(vld1q_f32(a), vld1q_f32(b)));
+            const uint32x4_t changed = vmvnq_u32(vcleq_f32(d, tol));  // NaN: <= is false -> changed
+            const uint16x4_t narrow = vmovn_u32(changed);
+            const auto bits = vget_lane_u64(vreinterpret_u64_u16(narrow), 0);
+            return static_cast<unsigned>((bits & 1) | ((bits >> 15) & 2) | ((bits >> 30) & 4) | ((bits >> 45) & 8));
+        }
+
+        std::size_t firstNeon(const float* a, const float* b, std::size_t from, std::size_t n, float t) noexcept {
+            const float32x4_t tol = vdupq_n_f32(t);
+            auto i = from;
+            for (; i + 4 <= n; i += 4) {
+                if (const auto m = mask4(a + i, b + i, tol)) return i + std::countr_zero(m);
+            }
+            return firstScalar(a, b, i, n, t);
+        }
+
+        void changedNeon(const float* a, const float* b, std::size_t from, std::size_t n, float t,
+                         std::vector<std::uint32_t>& out) {
+            const float32x4_t tol = vdupq_n_f32(t);
+            auto i = from;
+            for (; i + 4 <= n; i += 4) appendMask(mask4(a + i, b + i, tol), i, out);
+            changedScalarRange(a, b, i, n, t, out);
+        }
+
+        AnyFn selectFirst() noexcept { return firstNeon; }
+        ChangedFn selectChanged() noexcept { return changedNeon; }
+
+#else
+        AnyFn selectFirst() noexcept { return firstScalar; }
+        ChangedFn selectChanged() noexcept { return changedScalarRange; }
+#endif
+    }
+
+    namespace Helpers::FloatDiff {
+
+        bool any(Span a, Span b, float tolerance) noexcept {
+            static const AnyFn s_first = selectFirst();
+            const auto n = std::min(a.size(), b.size());
+            return s_first(a.data(), b.data(), 0, n, tolerance) != n;
+        }
+
+        std::size_t changed(Span a, Span b, float tolerance, std::vector<std::uint32_t>& out) {
+            static const ChangedFn s_changed = selectChanged();
+            const auto before = out.size();
+            s_changed(a.data(), b.data(), 0, std::min(a.size(), b.size()), tolerance, out);
+            return out.size() - before;
+        }
+
+        bool anyScalar(Span a, Span b, float tolerance) noexcept {
+            const auto n = std::min(a.size(), b.size());
+            return firstScalar(a.data(), b.data(), 0, n, tolerance) != n;
+        }
+
+        std::size_t changedScalar(Span a, Span b, float tolerance, std::vector<std::uint32_t>& out) {
+            const auto before = out.size();
+            changedScalarRange(a.data(), b.data(), 0, std::min(a.size(), b.size()), tolerance, out);
+            return out.size() - before;
+        }
+
+    }
+}  // namespace MorphFixer
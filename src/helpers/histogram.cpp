@@ -0,0 +1,43 @@
+#include "helpers/histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace MorphFixer {
+    namespace Helpers {
+
+        void LogLinearHistogram::record(std::uint64_t value) noexcept {
+            m_buckets[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+            m_count.fetch_add(1, std::memory_order_relaxed);
+
+            auto cur = m_max.load(std::memory_order_relaxed);
+            while (value > cur && !m_max.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {
+            }
+        }
+
+        std::uint64_t LogLinearHistogram::percentile(double q) const noexcept {
+            const auto total = count();
+            if (total == 0) return 0;
+
+            q = std::clamp(q, 0.0, 1.0);
+            const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(q * total)));
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < BUCKETS; ++i) {
+                seen += m_buckets[i].load(std::memory_order_relaxed);
+                if (seen >= rank) return std::min(bucketHigh(i), max());
+            }
+            return max();  // racing writers: count ran ahead of the buckets
+        }
+
+        LogLinearHistogram::Summary LogLinearHistogram::summary() const noexcept {
+            return {count(), percentile(0.50), percentile(0.99), max()};
+        }
+
+        void LogLinearHistogram::reset() noexcept {
+            for (auto& b : m_buckets) b.store(0, std::memory_order_relaxed);
+            m_count.store(0, std::memory_order_relaxed);
+            m_max.store(0, std::memory_order_relaxed);
+        }
+
+    }  // namespace Helpers
+}  // namespace MorphFixer
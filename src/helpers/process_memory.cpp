@@ -0,0 +1,20 @@
+#include "helpers/process_memory.h"
+
+#include <Windows.h>
+#include <psapi.h>  // K32GetProcessMemoryInfo
+
+namespace MorphFixer {
+    namespace Helpers::Process {
+
+        std::uint64_t privateBytes() noexcept {
+            PROCESS_MEMORY_COUNTERS_EX pmc{};
+            pmc.cb = sizeof(pmc);
+            if (!K32GetProcessMemoryInfo(GetCurrentProcess(), reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&pmc),
+                                         sizeof(pmc))) {
+                return 0;
+            }
+            return pmc.PrivateUsage;
+        }
+
+    }
+}
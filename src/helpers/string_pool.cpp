@@ -0,0 +1,116 @@
+#include "helpers/string_pool.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace MorphFixer {
+    namespace Helpers {
+
+        std::uint32_t StringPool::hashOf(std::string_view s) noexcept {
+            // 8 bytes per multiply (morph names are 10-40 chars), then a 64-bit finalizer
+            constexpr std::uint64_t K = 0x9E3779B97F4A7C15ull;
+            std::uint64_t h = s.size() * K;
+            std::size_t i = 0;
+            for (; i + 8 <= s.size(); i += 8) {
+                std::uint64_t w;
+                std::memcpy(&w, s.data() + i, 8);
+                h = (h ^ w) * K;
+                h ^= h >> 29;
+            }
+            if (i < s.size()) {
+                std::uint64_t w = 0;
+                std::memcpy(&w, s.data() + i, s.size() - i);
+                h = (h ^ w) * K;
+            }
+            h ^= h >> 32;
+            h *= 0xD6E8FEB86659FD93ull;
+            h ^= h >> 32;
+            return static_cast<std::uint32_t>(h);
+        }
+
+        std::size_t StringPool::probe(std::string_view s, std::uint32_t h) const noexcept {
+            const auto mask = m_table.size() - 1;
+            for (auto i = static_cast<std::size_t>(h) & mask;; i = (i + 1) & mask) {
+                const auto& slot = m_table[i];
+                if (slot.id == INVALID_ID) return i;
+                if (slot.hash != h) continue;
+                const auto& ref = m_strings[slot.id];
+                if (ref.size == s.size() && std::memcmp(ref.chars, s.data(), s.size()) == 0) return i;
+            }
+        }
+
+        StringPool::Id StringPool::find(std::string_view s) const noexcept {
+            if (m_table.empty()) return INVALID_ID;
+            return m_table[probe(s, hashOf(s))].id;
+        }
+
+        StringPool::Id StringPool::intern(std::string_view s) {
+            if ((m_strings.size() + 1) * 4 > m_table.size() * 3) {
+                rehash(std::max<std::size_t>(64, m_table.size() * 2));
+            }
+
+            const auto h = hashOf(s);
+            auto& slot = m_table[probe(s, h)];
+            if (slot.id != INVALID_ID) return slot.id;
+
+            const auto id = static_cast<Id>(m_strings.size());
+            m_strings.push_back({store(s), static_cast<std::uint32_t>(s.size())});
+            slot = {h, id};
+            return id;
+        }
+
+        void StringPool::reserve(std::size_t strings, std::size_t totalChars) {
+            const auto want = std::bit_ceil(std::max<std::size_t>(64, strings + strings / 3 + 1));
+            if (want > m_table.size()) rehash(want);
+            m_strings.reserve(strings);
+            if (totalChars > BLOCK_BYTES && m_block_used == m_block_size) {
+                // One block big enough for the whole seed (plus terminators)
+                m_blocks.push_back(std::make_unique<char[]>(totalChars + strings));
+                m_block_size = totalChars + strings;
+                m_block_used = 0;
+                m_arena_bytes += m_block_size;
+            }
+        }
+
+        const char* StringPool::store(std::string_view s) {
+            const auto need = s.size() + 1;
+            if (m_block_size - m_block_used < need) {
+                m_block_size = std::max(BLOCK_BYTES, need);
+                m_blocks.push_back(std::make_unique<char[]>(m_block_size));
+                m_block_used = 0;
+                m_arena_bytes += m_block_size;
+            }
+            char* dst = m_blocks.back().get() + m_block_used;
+            if (!s.empty()) std::memcpy(dst, s.data(), s.size());
+            dst[s.size()] = '\0';
+            m_block_used += need;
+            return dst;
+        }
+
+        void StringPool::rehash(std::size_t capacity) {
+            std::vector<Slot> table(capacity);
+            const auto mask = capacity - 1;
+            for (const auto& slot : m_table) {
+                if (slot.id == INVALID_ID) continue;
+                auto i = static_cast<std::size_t>(slot.hash) & mask;
+                while (table[i].id != INVALID_ID) i = (i + 1) & mask;
+                table[i] = slot;
+            }
+            m_table.swap(table);
+        }
+
+        std::string_view StringPool::nameOf(Id id) const noexcept {
+            if (id >= m_strings.size()) return {};
+            return {m_strings[id].chars, m_strings[id].size};
+        }
+
+        const char* StringPool::c_str(Id id) const noexcept { return id < m_strings.size() ? m_strings[id].chars : ""; }
+
+        std::size_t StringPool::memoryBytes() const noexcept {
+            return m_arena_bytes + m_table.capacity() * sizeof(Slot) + m_strings.capacity() * sizeof(Ref) +
+                   m_blocks.capacity() * sizeof(std::unique_ptr<char[]>);
+        }
+
+    }
+}  // namespace MorphFixer
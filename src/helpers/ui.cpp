@@ -1,13 +1,39 @@
 #include "helpers/ui.h"
 
+#include "core/timer_wheel.h"
 #include "helpers/consts.h"
 #include "logger.h"
 #include "pch.h"
 
 namespace MorphFixer {
     namespace {
-        using clock = std::chrono::steady_clock;
-        std::unordered_map<std::string, clock::time_point> g_last_mssg_snapshot;
+        // One wheel timer per throttle key, created on the key's first use; "cooling" is cleared
+        // when the cooldown elapses. A fixed table keeps the throttles' share of the wheel's pool
+        // bounded; entries never move or go away.
+        struct Throttle {
+            std::string key;
+            TimerWheel::TimerId timer{TimerWheel::INVALID_TIMER};
+            std::atomic_bool cooling{false};
+        };
+        std::mutex g_throttle_mu;
+        std::array<Throttle, Helpers::Ui::MAX_THROTTLE_KEYS> g_throttles;
+        std::size_t g_throttle_count = 0;
+
+        // nullptr when the table or the wheel's pool is full
+        Throttle* throttleFor(const std::string_view key) {
+            std::lock_guard lk(g_throttle_mu);
+            for (std::size_t i = 0; i < g_throttle_count; ++i) {
+                if (g_throttles[i].key == key) return &g_throttles[i];
+            }
+            if (g_throttle_count == g_throttles.size()) return nullptr;
+
+            auto& t = g_throttles[g_throttle_count];
+            t.timer = TimerWheel::get().create([&t] { t.cooling.store(false, std::memory_order_relaxed); });
+            if (t.timer == TimerWheel::INVALID_TIMER) return nullptr;
+            t.key.assign(key.data(), key.size());
+            ++g_throttle_count;
+            return &t;
+        }
     }
 
     namespace Helpers::Ui {
@@ -33,14 +59,18 @@ namespace MorphFixer {
 
         void notifyThrottled(const std::string_view key, const std::string_view msg,
                              const std::chrono::milliseconds cooldown) {
-            const auto now = clock::now();
-            auto& last = g_last_mssg_snapshot[std::string(key)];
-            if (last.time_since_epoch().count() == 0 || now - last >= cooldown) {
-                last = now;
+            auto* throttle = throttleFor(key);
+            if (!throttle) {
+                LOG_DEBUG("notify key '{}' not throttled: no free throttle slot", std::string(key));
                 notify(msg);
-            } else {
+                return;
+            }
+            if (throttle->cooling.exchange(true, std::memory_order_relaxed)) {
                 LOG_DEBUG("suppressed notify '{}' (cooldown {} ms)", std::string(msg), cooldown.count());
+                return;
             }
+            TimerWheel::get().arm(throttle->timer, cooldown);
+            notify(msg);
         }
 
     }  // namespace Helpers::Ui
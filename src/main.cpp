@@ -1,7 +1,12 @@
 #include <SimpleIni.h>
 
 #include "core/arrow_weight_sink.h"
+#include "core/ei_dispatch.h"
+#include "core/ei_recorder.h"
+#include "core/racemenu_ei_driver.h"
 #include "core/racemenu_watcher.h"
+#include "core/timer_wheel.h"
+#include "features/morph_cache.h"
 #include "features/morph_updater.h"
 #include "helpers/keybind.h"
 #include "logger.h"
@@ -41,12 +46,38 @@ static void loadMorphInterface() {
 
     LOG_INFO("[SKEE] BodyMorph version {}", morphInterface->GetVersion());
     MorphFixer::MorphUpdater::get().setMorphInterface(morphInterface);
+    MorphFixer::MorphCache::get().setMorphInterface(morphInterface);
+}
+
+// Consumers of the RaceMenu movie's EI calls; fixed for the life of the plugin.
+static void registerEiObservers() {
+    using MorphFixer::EiDispatch;
+    using EventClass = MorphFixer::Helpers::EventClassifier::EventClass;
+
+    auto& d = EiDispatch::get();
+    bool ok = d.subscribe(EiDispatch::Phase::kBeforeOriginal, EiDispatch::ALL_CLASSES,
+                          MorphFixer::Helpers::RaceMenuExternalInterface::observe);
+    ok &= d.subscribe(EiDispatch::Phase::kAfterOriginal,
+                      EiDispatch::maskOf(EventClass::kWeight) | EiDispatch::maskOf(EventClass::kSlider) |
+                          EiDispatch::maskOf(EventClass::kPresetChange),
+                      [](const MorphFixer::EiEvent& ev) { MorphFixer::MorphUpdater::get().onGfxEvent(ev); });
+    if (!ok) LOG_WARN("[gfx-ei] a dispatch row is full; an observer misses some event classes");
 }
 
 static void onDataLoaded() {
     MorphFixer::Settings::get().load();
 
-    MorphFixer::MorphUpdater::get().setThrottleMs(MorphFixer::Settings::get().throttle_ms);
+    const auto& cfg = MorphFixer::Settings::get();
+    MorphFixer::MorphUpdater::get().setCadenceConfig({cfg.adaptive, cfg.throttle_ms, cfg.throttle_min_ms,
+                                                      cfg.throttle_max_ms, cfg.idle_gap_ms, cfg.idle_gap_min_ms,
+                                                      cfg.idle_gap_max_ms});
+    MorphFixer::MorphUpdater::get().setRefreshMode(cfg.refresh_skee ? MorphFixer::CadenceEngine::RefreshMode::kSkee
+                                                                    : MorphFixer::CadenceEngine::RefreshMode::kNudge);
+    MorphFixer::MorphUpdater::get().setSkipUnchanged(cfg.skip_unchanged);
+    MorphFixer::MorphCache::get().configure({cfg.cache_manage, cfg.cache_limit_min_mb, cfg.cache_limit_max_mb,
+                                              cfg.cache_low_water_mb, cfg.cache_high_water_mb, cfg.cache_poll_ms});
+    MorphFixer::EiRecorder::get().setEnabled(cfg.record_ei);
+    registerEiObservers();
 
     if (auto* ui = RE::UI::GetSingleton()) {
         ui->AddEventSink<RE::MenuOpenCloseEvent>(&MorphFixer::RaceMenuWatcher::get());
@@ -93,12 +124,28 @@ static void onMessage(SKSE::MessagingInterface::Message* m) {
         case SKSE::MessagingInterface::kPostLoadGame:
         case SKSE::MessagingInterface::kNewGame: {
             MorphFixer::Settings::get().load();
+            MorphFixer::MorphCache::get().onSafePoint(m->type == SKSE::MessagingInterface::kNewGame ? "new game"
+                                                                                                  : "save loaded");
         } break;
         default:
             break;
     }
 }
 
+// Plugin teardown. SKSE sends no exit message, so this runs from DllMain under the loader lock.
+// On FreeLibrary our threads are still running plugin code and are stopped before it is unmapped.
+// At process exit Windows has already terminated them: there is nothing to stop, and a lock one of
+// them held is never released, so nothing here (or in a static destructor) may wait on one.
+static void onPluginUnload(bool processExit) {
+    if (processExit) return;
+    MorphFixer::TimerWheel::get().shutdown();
+}
+
+BOOL APIENTRY DllMain(HMODULE, DWORD reason, LPVOID reserved) {
+    if (reason == DLL_PROCESS_DETACH) onPluginUnload(reserved != nullptr);
+    return TRUE;
+}
+
 SKSEPluginLoad(const SKSE::LoadInterface* skse) {
     SKSE::Init(skse);
     MorphFixer::Logger::init();
@@ -3,6 +3,7 @@
 #include <SimpleIni.h>
 #include <windows.h>  // GetModuleHandleExW, GetModuleFileNameW
 
+#include "helpers/ascii.h"
 #include "helpers/string.h"
 #include "logger.h"
 #include "pch.h"
@@ -85,7 +86,31 @@ namespace MorphFixer {
 
         // ---- general (section names chosen to keep room for future options) ----
         throttle_ms = static_cast<int>(ini.GetLongValue(L"delays", L"throttle_ms", throttle_ms));
-
-        LOG_INFO("[config] loaded '{}' (throttle_ms={})", Helpers::String::toUtf8(m_ini_path), throttle_ms);
+        adaptive = ini.GetBoolValue(L"delays", L"adaptive", adaptive);
+        throttle_min_ms = static_cast<int>(ini.GetLongValue(L"delays", L"throttle_min_ms", throttle_min_ms));
+        throttle_max_ms = static_cast<int>(ini.GetLongValue(L"delays", L"throttle_max_ms", throttle_max_ms));
+        idle_gap_ms = static_cast<int>(ini.GetLongValue(L"delays", L"idle_gap_ms", idle_gap_ms));
+        idle_gap_min_ms = static_cast<int>(ini.GetLongValue(L"delays", L"idle_gap_min_ms", idle_gap_min_ms));
+        idle_gap_max_ms = static_cast<int>(ini.GetLongValue(L"delays", L"idle_gap_max_ms", idle_gap_max_ms));
+
+        const auto mode = Helpers::String::toUtf8(ini.GetValue(L"refresh", L"mode", L"nudge"));
+        refresh_skee = Helpers::Ascii::equalsIgnoreCase(mode, "skee");
+        skip_unchanged = ini.GetBoolValue(L"refresh", L"skip_unchanged", skip_unchanged);
+        cache_manage = ini.GetBoolValue(L"cache", L"manage", cache_manage);
+        cache_limit_min_mb = static_cast<int>(ini.GetLongValue(L"cache", L"limit_min_mb", cache_limit_min_mb));
+        cache_limit_max_mb = static_cast<int>(ini.GetLongValue(L"cache", L"limit_max_mb", cache_limit_max_mb));
+        cache_low_water_mb = static_cast<int>(ini.GetLongValue(L"cache", L"low_water_mb", cache_low_water_mb));
+        cache_high_water_mb = static_cast<int>(ini.GetLongValue(L"cache", L"high_water_mb", cache_high_water_mb));
+        cache_poll_ms = static_cast<int>(ini.GetLongValue(L"cache", L"poll_ms", cache_poll_ms));
+        record_ei = ini.GetBoolValue(L"debug", L"record_ei", record_ei);
+        const auto observe = Helpers::String::toUtf8(ini.GetValue(L"debug", L"observe_menus", L""));
+        observe_menus = Helpers::String::splitList(observe);
+
+        LOG_INFO("[config] loaded '{}' (throttle_ms={} [{}..{}], idle_gap_ms={} [{}..{}], adaptive={})",
+                 Helpers::String::toUtf8(m_ini_path), throttle_ms, throttle_min_ms, throttle_max_ms, idle_gap_ms,
+                 idle_gap_min_ms, idle_gap_max_ms, adaptive);
+        LOG_INFO("[config] refresh mode: {} (skip_unchanged={})", refresh_skee ? "skee" : "nudge", skip_unchanged);
+        if (record_ei) LOG_INFO("[config] EI recorder enabled");
+        for (const auto& m : observe_menus) LOG_INFO("[config] observing EI calls of '{}'", m);
     }
 }  // namespace MorphFixer
@@ -0,0 +1,135 @@
+// arg0_stress: concurrency stress test for Arg0Sequence, the ChangeWeight arg0 allocator.
+//
+// Driver threads reserve single slots and nudge+restore pairs while a "RaceMenu" thread feeds
+// native arg0s through observe(), restarting its own numbering at 0 every session, as the worst
+// case of a movie reopen. resetStats() runs between sessions, as on every menu open.
+//
+// Fails (exit 1) when:
+//   - any slot is handed out twice, within or across sessions
+//   - a reservation is not above a native slot the same thread observed before it
+//   - the reserved counter disagrees with the slots handed out
+// Native slots landing on a recent reservation are collisions RaceMenu itself caused; they are
+// reported, not failed.
+//
+// usage: arg0_stress [--threads N] [--reserves N] [--sessions N]
+//   --threads <n>    driver threads (default 8)
+//   --reserves <n>   reservations per thread per session (default 100000)
+//   --sessions <n>   menu sessions (default 4)
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "core/arg0_sequence.h"
+
+namespace {
+    using MorphFixer::Arg0Sequence;
+
+    struct Options {
+        int threads{8};
+        int reserves{100000};
+        int sessions{4};
+    };
+
+    struct ThreadResult {
+        std::vector<std::int64_t> slots;
+        std::uint64_t orderErrors{0};  // reservation not above a slot this thread observed
+    };
+
+    void driver(Arg0Sequence& seq, int reserves, unsigned seed, ThreadResult& out) {
+        std::int64_t seen = -1;  // highest native slot this thread fed in
+        for (int i = 0; i < reserves; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            if ((seed >> 28) == 0) {
+                // Drivers observe the native calls too (EiDispatch runs on whichever thread calls)
+                const auto s = seq.stats().next + static_cast<std::int64_t>((seed >> 8) & 3);
+                seq.observe(static_cast<double>(s));
+                seen = std::max(seen, s);
+                continue;
+            }
+            const std::uint32_t count = (seed >> 24) & 1 ? 2 : 1;
+            const auto base = seq.reserve(count);
+            if (base <= seen) ++out.orderErrors;
+            for (std::uint32_t k = 0; k < count; ++k) out.slots.push_back(base + k);
+        }
+    }
+
+    bool parseArgs(int argc, char** argv, Options& opt) {
+        for (int i = 1; i + 1 < argc; i += 2) {
+            const std::string_view a = argv[i];
+            const int v = std::atoi(argv[i + 1]);
+            if (a == "--threads") {
+                opt.threads = v;
+            } else if (a == "--reserves") {
+                opt.reserves = v;
+            } else if (a == "--sessions") {
+                opt.sessions = v;
+            } else {
+                return false;
+            }
+        }
+        return argc % 2 == 1 && opt.threads > 0 && opt.reserves > 0 && opt.sessions > 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        std::fprintf(stderr, "usage: %s [--threads N] [--reserves N] [--sessions N]\n", argv[0]);
+        return 2;
+    }
+
+    Arg0Sequence seq;
+    std::vector<std::int64_t> all;
+    std::uint64_t orderErrors = 0, counterErrors = 0, collisions = 0;
+
+    for (int session = 0; session < opt.sessions; ++session) {
+        seq.resetStats();
+
+        std::vector<ThreadResult> results(static_cast<std::size_t>(opt.threads));
+        std::atomic<bool> done{false};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < opt.threads; ++t) {
+            threads.emplace_back(driver, std::ref(seq), opt.reserves, 0x9E3779B9u * static_cast<unsigned>(t + 1),
+                                 std::ref(results[static_cast<std::size_t>(t)]));
+        }
+        // RaceMenu's own calls: a counter restarting at 0 with the movie
+        std::thread native([&] {
+            for (std::int64_t n = 0; !done.load(std::memory_order_relaxed); ++n) seq.observe(static_cast<double>(n));
+        });
+        for (auto& th : threads) th.join();
+        done.store(true);
+        native.join();
+
+        const auto st = seq.stats();
+        std::size_t reserved = 0;
+        for (auto& r : results) {
+            reserved += r.slots.size();
+            orderErrors += r.orderErrors;
+            all.insert(all.end(), r.slots.begin(), r.slots.end());
+        }
+        collisions += st.collisions;
+        std::printf("session %d: reserved=%llu (counted %llu) observed=%llu collisions=%llu next=%lld\n", session,
+                    static_cast<unsigned long long>(reserved), static_cast<unsigned long long>(st.reserved),
+                    static_cast<unsigned long long>(st.observed), static_cast<unsigned long long>(st.collisions),
+                    static_cast<long long>(st.next));
+        if (st.reserved != reserved) {
+            std::printf("  CHECK FAILED: reserved counter %llu != %zu slots handed out\n",
+                        static_cast<unsigned long long>(st.reserved), reserved);
+            ++counterErrors;
+        }
+    }
+
+    std::sort(all.begin(), all.end());
+    const auto dupes = static_cast<std::size_t>(all.end() - std::unique(all.begin(), all.end()));
+
+    std::printf("total: slots=%zu duplicates=%zu order_errors=%llu native_collisions=%llu\n", all.size(), dupes,
+                static_cast<unsigned long long>(orderErrors), static_cast<unsigned long long>(collisions));
+    return (dupes || orderErrors || counterErrors) ? 1 : 0;
+}
@@ -0,0 +1,177 @@
+// ascii_check: checks Ascii::findIgnoreCase (the SIMD dispatch) against findIgnoreCaseScalar and
+// times both, on the event names the plugin actually routes and on longer haystacks.
+//
+//   check  - random haystacks of every length up to --max-len with mixed case, '_' and UTF-8
+//            bytes, needles cut from the haystack (a hit) or random (mostly a miss); the two
+//            must return the same offset
+//   bench  - ns per call on real ExternalInterface / mod event names, then on synthetic
+//            haystacks long enough for the vector loop to run
+//
+// Exits 1 on any mismatch.
+//
+// usage: ascii_check [--cases N] [--max-len N] [--iters N]
+//   --cases <n>    random haystack/needle pairs per length (default 200)
+//   --max-len <n>  longest random haystack (default 160)
+//   --iters <n>    calls per timing (default 2000000)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+#include "helpers/ascii.h"
+#include "helpers/cpu_features.h"
+
+namespace {
+    namespace Ascii = MorphFixer::Helpers::Ascii;
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        int cases{200};
+        int max_len{160};
+        int iters{2000000};
+    };
+
+    // Names the routing code sees (RaceMenu EI callbacks, mod events) and the needles it looks for
+    constexpr std::string_view REAL_NAMES[] = {
+        "ChangeWeight",        "ChangeHeadPart",            "ChangeTintingMask",     "ChangeDoubleMorph",
+        "ChangePreset",        "RSM_SliderChange",          "RM_OnSliderChange",     "OBody_SetMorph",
+        "TNGAroused_SetMorph", "NiOverrideUpdateBodyMorph", "RaceMenuSliderChanged",
+    };
+    constexpr std::string_view REAL_NEEDLES[] = {"Slider", "Preset", "Change"};
+
+    template <class Fn>
+    double nsPerCall(int iters, Fn&& fn) {
+        const auto t0 = Clock::now();
+        for (int i = 0; i < iters; ++i) fn(i);
+        return std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / iters;
+    }
+
+    std::string randomText(std::size_t len, unsigned& r) {
+        // Few distinct letters so partial first/last-byte matches are common
+        constexpr std::string_view ALPHABET = "aAbBsSlLiIdDeErR_\xC3\xA9 ";
+        std::string s(len, ' ');
+        for (auto& c : s) {
+            r = r * 1664525u + 1013904223u;
+            c = ALPHABET[(r >> 8) % ALPHABET.size()];
+        }
+        return s;
+    }
+
+    std::string flipCase(std::string s, unsigned& r) {
+        for (auto& c : s) {
+            r = r * 1664525u + 1013904223u;
+            if (((r >> 20) & 1) && ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))) c ^= 0x20;
+        }
+        return s;
+    }
+
+    std::size_t checkRandom(const Options& opt) {
+        std::size_t pairs = 0, hits = 0, mismatches = 0;
+        unsigned r = 0x5EEDu;
+        for (int len = 0; len <= opt.max_len; ++len) {
+            for (int c = 0; c < opt.cases; ++c) {
+                const auto hay = randomText(static_cast<std::size_t>(len), r);
+                std::string needle;
+                r = r * 1664525u + 1013904223u;
+                const auto m = 1 + (r >> 8) % 12;
+                if (len > 0 && (r >> 24) & 1) {
+                    const auto at = (r >> 4) % static_cast<unsigned>(len);
+                    needle = flipCase(hay.substr(at, m), r);
+                } else {
+                    needle = randomText(m, r);
+                }
+                const auto fast = Ascii::findIgnoreCase(hay, needle);
+                const auto ref = Ascii::findIgnoreCaseScalar(hay, needle);
+                ++pairs;
+                if (ref != std::string_view::npos) ++hits;
+                if (fast != ref) {
+                    if (mismatches++ < 5) {
+                        std::printf("  MISMATCH hay=\"%s\" needle=\"%s\" simd=%zu scalar=%zu\n", hay.c_str(),
+                                    needle.c_str(), fast, ref);
+                    }
+                }
+            }
+        }
+        for (const auto name : REAL_NAMES) {
+            for (const auto needle : REAL_NEEDLES) {
+                ++pairs;
+                if (Ascii::findIgnoreCase(name, needle) != Ascii::findIgnoreCaseScalar(name, needle)) ++mismatches;
+            }
+        }
+        std::printf("check: %zu pair(s), %zu hit(s), %zu mismatch(es), avx2=%s\n", pairs, hits, mismatches,
+                    MorphFixer::Helpers::Cpu::hasAvx2() ? "yes" : "no");
+        return mismatches;
+    }
+
+    void benchReal(const Options& opt) {
+        constexpr auto N = std::size(REAL_NAMES);
+        std::size_t shortest = 1000, longest = 0;
+        for (const auto n : REAL_NAMES) {
+            shortest = std::min(shortest, n.size());
+            longest = std::max(longest, n.size());
+        }
+        volatile std::size_t sink = 0;
+        const auto simd = nsPerCall(opt.iters, [&](int i) {
+            sink = sink + Ascii::findIgnoreCase(REAL_NAMES[static_cast<std::size_t>(i) % N], "Slider");
+        });
+        const auto scalar = nsPerCall(opt.iters, [&](int i) {
+            sink = sink + Ascii::findIgnoreCaseScalar(REAL_NAMES[static_cast<std::size_t>(i) % N], "Slider");
+        });
+        const auto find = nsPerCall(opt.iters, [&](int i) {
+            sink = sink + REAL_NAMES[static_cast<std::size_t>(i) % N].find("Slider");
+        });
+        std::printf("bench: real names (%zu-%zu chars), needle \"Slider\"\n", shortest, longest);
+        std::printf("  findIgnoreCase %.1f ns, findIgnoreCaseScalar %.1f ns, string_view::find %.1f ns\n", simd,
+                    scalar, find);
+    }
+
+    void benchLong(const Options& opt) {
+        std::printf("bench: synthetic haystacks ending in \"RaceMenuSlider\"\n");
+        unsigned r = 0xBEEFu;
+        for (const std::size_t len : {32u, 64u, 256u, 4096u}) {
+            const auto hay = randomText(len, r) + "RaceMenuSlider";
+            const int iters = std::max(1, static_cast<int>(opt.iters / (1 + len / 64)));
+            volatile std::size_t sink = 0;
+            const auto simd = nsPerCall(iters, [&](int) { sink = sink + Ascii::findIgnoreCase(hay, "Slider"); });
+            const auto scalar =
+                nsPerCall(iters, [&](int) { sink = sink + Ascii::findIgnoreCaseScalar(hay, "Slider"); });
+            std::printf("  %5zu chars: findIgnoreCase %.1f ns, findIgnoreCaseScalar %.1f ns\n", hay.size(), simd,
+                        scalar);
+        }
+    }
+
+    bool parseArgs(int argc, char** argv, Options& opt) {
+        for (int i = 1; i + 1 < argc; i += 2) {
+            const std::string_view a = argv[i];
+            const int v = std::atoi(argv[i + 1]);
+            if (a == "--cases") {
+                opt.cases = v;
+            } else if (a == "--max-len") {
+                opt.max_len = v;
+            } else if (a == "--iters") {
+                opt.iters = v;
+            } else {
+                return false;
+            }
+        }
+        return argc % 2 == 1 && opt.cases > 0 && opt.max_len >= 0 && opt.iters > 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        std::fprintf(stderr, "usage: %s [--cases N] [--max-len N] [--iters N]\n", argv[0]);
+        return 2;
+    }
+
+    const auto mismatches = checkRandom(opt);
+    benchReal(opt);
+    benchLong(opt);
+
+    if (mismatches) std::printf("FAILED: SIMD and scalar results differ\n");
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,269 @@
+// cadence_contention: events/s through the slider cadence decision with N producer threads, for
+// the lock-free CadenceEngine::onEvent and the mutex-guarded decision it replaced.
+//
+//   lockfree - CadenceEngine::onEvent with the name already resolved, as EiDispatch hands it over:
+//              CAS on the apply stamp, coalescing slot, tail re-arm
+//   mutex    - the old onGfxEvent step: one function-static mutex, the last name kept in a
+//              std::string, and a std::string copy of the name per posted task
+//
+// Producers send RaceMenu slider names on a real clock; with --names 1 (the default) they all
+// drag the same slider. Posted tasks run inline in the sink (the driver is never ready, so
+// nothing is driven) and free the coalescing slot right away; the lockfree row pays for that
+// task run, the mutex row has no task to run. --throttle-ms 0 is the worst case: every event
+// tries to claim the window.
+//
+// Exits 1 when an event is lost: every event must come back as posted, merged or throttled, and
+// the sink must see exactly the posted ones.
+//
+// usage: cadence_contention [--threads N] [--ms N] [--throttle-ms N] [--names N]
+//   --threads <n>      runs with 1, 2, 4 ... up to n producer threads (default 4)
+//   --ms <n>           duration of each run (default 300)
+//   --throttle-ms <n>  throttle window (default 100, the INI default)
+//   --names <n>        distinct slider names the producers rotate through, 1..4 (default 1)
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "features/cadence_engine.h"
+
+namespace {
+    using MorphFixer::CadenceEngine;
+    using MorphFixer::UiCommand;
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        int threads{4};
+        int ms{300};
+        int throttle_ms{100};
+        int names{1};
+    };
+
+    int g_failed = 0;
+
+    void check(bool ok, const char* what) {
+        if (ok) return;
+        if (++g_failed <= 20) std::printf("  CHECK FAILED: %s\n", what);
+    }
+
+    constexpr std::string_view NAMES[] = {"ChangeDoubleMorph", "ChangeHeadPart", "ChangeTintingMask",
+                                          "ChangeMaskColor"};
+    constexpr int NAME_COUNT = static_cast<int>(std::size(NAMES));
+
+    long long nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    struct SteadyClock final : CadenceEngine::Clock {
+        [[nodiscard]] long long nowNs() const noexcept override { return ::nowNs(); }
+    };
+
+    struct FixedWeight final : CadenceEngine::WeightSource {
+        [[nodiscard]] double currentNorm() noexcept override { return 0.5; }
+    };
+
+    struct IdleDriver final : CadenceEngine::WeightDriver {
+        [[nodiscard]] bool ready() noexcept override { return false; }
+        bool drive(double) noexcept override { return true; }
+        bool nudgeRestore(double, double) noexcept override { return true; }
+        [[nodiscard]] bool canRefresh() noexcept override { return false; }
+        bool refresh() noexcept override { return true; }
+        [[nodiscard]] bool morphsChanged() noexcept override { return true; }
+    };
+
+    // Runs posted tasks on the producer, like UiTaskChannel's inline drain
+    struct InlineSink final : CadenceEngine::TaskSink {
+        CadenceEngine* engine{nullptr};
+        std::atomic<std::uint64_t> submitted{0};
+        std::atomic<long long> tailDue{-1};
+
+        bool submit(const UiCommand& cmd) noexcept override {
+            submitted.fetch_add(1, std::memory_order_relaxed);
+            engine->runTask(cmd);
+            return true;
+        }
+        bool submitSettle(const UiCommand&) noexcept override { return false; }
+        void armTail(long long dueNs) noexcept override { tailDue.store(dueNs, std::memory_order_relaxed); }
+        void cancelTail() noexcept override { tailDue.store(-1, std::memory_order_relaxed); }
+        [[nodiscard]] std::size_t depth() const noexcept override { return 0; }
+    };
+
+    // The decision as onGfxEvent made it before the engine: everything under one mutex
+    struct MutexCadence {
+        std::mutex mu;
+        std::string lastName;
+        long long lastAppliedNs{-1};
+        long long tailDueNs{-1};
+        long long throttleNs{0};
+        std::atomic<std::uint64_t> posted{0};
+        std::atomic<std::uint64_t> throttled{0};
+        std::atomic<std::uint64_t> taskChars{0};
+
+        void onEvent(std::string_view name) {
+            std::lock_guard lk(mu);
+            const auto now = nowNs();
+            const bool nameChanged = lastName != name;
+            const bool ok = nameChanged || lastAppliedNs < 0 || (now - lastAppliedNs) >= throttleNs;
+            if (ok) {
+                std::string src(name);  // captured by the posted task
+                taskChars.fetch_add(src.size(), std::memory_order_relaxed);
+                lastName.assign(name.data(), name.size());
+                lastAppliedNs = now;
+                posted.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                throttled.fetch_add(1, std::memory_order_relaxed);
+            }
+            tailDueNs = now + throttleNs;
+        }
+    };
+
+    struct Run {
+        double seconds{0};
+        std::uint64_t events{0};
+        std::uint64_t posted{0};
+        std::uint64_t merged{0};
+        std::uint64_t throttled{0};
+    };
+
+    // Each producer fires events (by name index) until the deadline; returns how many were sent
+    template <class Fire>
+    Run produce(int threads, int ms, int names, Fire&& fire) {
+        std::atomic<bool> go{false};
+        std::atomic<bool> stop{false};
+        std::vector<std::uint64_t> counts(static_cast<std::size_t>(threads), 0);
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads; ++t) {
+            pool.emplace_back([&, t] {
+                while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+                std::uint64_t n = 0;
+                auto i = static_cast<std::size_t>(t);
+                while (!stop.load(std::memory_order_relaxed)) {
+                    fire(i++ % static_cast<std::size_t>(names));
+                    ++n;
+                }
+                counts[static_cast<std::size_t>(t)] = n;
+            });
+        }
+        const auto t0 = Clock::now();
+        go.store(true, std::memory_order_release);
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+        stop.store(true, std::memory_order_relaxed);
+        for (auto& th : pool) th.join();
+
+        Run r;
+        r.seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+        for (const auto c : counts) r.events += c;
+        return r;
+    }
+
+    Run runLockFree(const Options& opt, int threads) {
+        SteadyClock clock;
+        FixedWeight weights;
+        IdleDriver driver;
+        InlineSink sink;
+        CadenceEngine engine(clock, sink, weights, driver);
+        sink.engine = &engine;
+
+        MorphFixer::AdaptiveThrottle::Config cfg;
+        cfg.enabled = false;
+        cfg.throttle_ms = opt.throttle_ms;
+        engine.configure(cfg);
+        engine.setEnabled(true);
+
+        std::vector<MorphFixer::Helpers::EventNames::EventInfo> infos;
+        for (const auto name : NAMES) infos.push_back(MorphFixer::Helpers::EventNames::resolve(name));
+
+        std::atomic<std::uint64_t> posted{0}, merged{0}, throttled{0}, other{0};
+        auto r = produce(threads, opt.ms, opt.names, [&](std::size_t k) {
+            switch (engine.onEvent(infos[k], std::nullopt)) {
+                case CadenceEngine::EventResult::kPosted:
+                    posted.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                case CadenceEngine::EventResult::kMerged:
+                    merged.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                case CadenceEngine::EventResult::kThrottled:
+                    throttled.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                default:
+                    other.fetch_add(1, std::memory_order_relaxed);
+                    break;
+            }
+        });
+        r.posted = posted.load();
+        r.merged = merged.load();
+        r.throttled = throttled.load();
+
+        const auto st = engine.stats();
+        check(other.load() == 0, "lockfree: event neither posted, merged nor throttled");
+        check(r.posted + r.merged + r.throttled == r.events, "lockfree: results do not add up to the events sent");
+        check(st.received == r.events && st.merged == r.merged && st.throttled == r.throttled,
+              "lockfree: engine counters disagree with the results");
+        check(sink.submitted.load() == r.posted, "lockfree: sink saw a different number of posts");
+        return r;
+    }
+
+    Run runMutex(const Options& opt, int threads) {
+        MutexCadence m;
+        m.throttleNs = static_cast<long long>(opt.throttle_ms) * 1'000'000LL;
+        auto r = produce(threads, opt.ms, opt.names, [&](std::size_t k) { m.onEvent(NAMES[k]); });
+        r.posted = m.posted.load();
+        r.throttled = m.throttled.load();
+        check(r.posted + r.throttled == r.events, "mutex: results do not add up to the events sent");
+        return r;
+    }
+
+    void print(const char* name, int threads, const Run& r) {
+        std::printf("%-8s %2d threads  %7.2f M events/s  %6.1f ns/event  posted=%llu merged=%llu throttled=%llu\n",
+                    name, threads, static_cast<double>(r.events) / r.seconds / 1e6,
+                    r.seconds * 1e9 * threads / static_cast<double>(r.events),
+                    static_cast<unsigned long long>(r.posted), static_cast<unsigned long long>(r.merged),
+                    static_cast<unsigned long long>(r.throttled));
+    }
+
+    bool parseArgs(int argc, char** argv, Options& opt) {
+        for (int i = 1; i + 1 < argc; i += 2) {
+            const std::string_view a = argv[i];
+            const int v = std::atoi(argv[i + 1]);
+            if (a == "--threads") {
+                opt.threads = v;
+            } else if (a == "--ms") {
+                opt.ms = v;
+            } else if (a == "--throttle-ms") {
+                opt.throttle_ms = v;
+            } else if (a == "--names") {
+                opt.names = v;
+            } else {
+                return false;
+            }
+        }
+        return argc % 2 == 1 && opt.threads > 0 && opt.ms > 0 && opt.throttle_ms >= 0 && opt.names > 0 &&
+               opt.names <= NAME_COUNT;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        std::fprintf(stderr, "usage: %s [--threads N] [--ms N] [--throttle-ms N] [--names 1..4]\n", argv[0]);
+        return 2;
+    }
+    std::printf("%u hardware threads, throttle %d ms, %d slider name(s), %d ms per run\n",
+                std::thread::hardware_concurrency(), opt.throttle_ms, opt.names, opt.ms);
+
+    for (int threads = 1; threads <= opt.threads; threads *= 2) {
+        print("lockfree", threads, runLockFree(opt, threads));
+        print("mutex", threads, runMutex(opt, threads));
+    }
+
+    if (g_failed) std::printf("FAILED (%d checks)\n", g_failed);
+    return g_failed ? 1 : 0;
+}
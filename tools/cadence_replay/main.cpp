@@ -0,0 +1,362 @@
+// cadence_replay: feeds recorded RaceMenu ExternalInterface traces through CadenceEngine under
+// virtual time and reports how many ChangeWeight drives and tail flushes each trace produces.
+//
+// Trace format, one callback per line ('#' starts a comment):
+//   <time_ms> <EI callback name> [numeric args...]
+// ChangeWeight's second argument is the normalized weight, as in the game.
+// Binary *.rmft session dumps (EiRecorder) are accepted as well; only RaceMenu-originated
+// callbacks are replayed, since the engine issues its own ChangeWeight drives.
+//
+// usage: cadence_replay [options] <trace>...
+//   --frame-ms <ms>      UI frame period; queued tasks run on the next frame (default 16.667)
+//   --drive-ms <ms>      virtual cost of one ChangeWeight drive (default 0)
+//   --mesh-ms <ms>       virtual cost of the mesh update each refresh queues; it runs in the next
+//                        frame's task pass, ahead of the settle that closes the cadence sample (default 0)
+//   --weight <norm>      live weight when no ChangeWeight was seen (default 0.5)
+//   --skee               SKEE refresh mode instead of the ChangeWeight nudge
+//   --adaptive           tune throttle / idle gap from the measured drive -> settle time (the default,
+//                        as in the INI)
+//   --fixed              fixed cadence (use --throttle-ms / --idle-gap-ms as is)
+//   --throttle-ms <ms>   start throttle (default 100)
+//   --idle-gap-ms <ms>   start tail idle gap (default 150)
+//   -v                   print every drive and tail flush
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/ei_trace_format.h"
+#include "features/cadence_engine.h"
+#include "helpers/consts.h"
+
+namespace {
+    using MorphFixer::CadenceEngine;
+    using MorphFixer::UiCommand;
+    using MorphFixer::Helpers::Consts::NS_PER_MS;
+
+    struct Options {
+        double frame_ms{1000.0 / 60.0};
+        double drive_ms{0.0};
+        double mesh_ms{0.0};
+        double weight{0.5};
+        MorphFixer::AdaptiveThrottle::Config cadence{};
+        bool verbose{false};
+        bool skee{false};
+    };
+
+    struct TraceEvent {
+        long long t_ns{0};
+        std::string name;
+        std::vector<std::optional<double>> args;
+    };
+
+    long long msToNs(double ms) { return std::llround(ms * static_cast<double>(NS_PER_MS)); }
+    double nsToMs(long long ns) { return static_cast<double>(ns) / static_cast<double>(NS_PER_MS); }
+
+    std::optional<double> parseNumber(std::string_view s) {
+        double v{};
+        const auto [p, ec] = std::from_chars(s.data(), s.data() + s.size(), v);
+        if (ec != std::errc{} || p != s.data() + s.size()) return std::nullopt;
+        return v;
+    }
+
+    bool loadRecorded(std::istream& in, const std::string& path, std::vector<TraceEvent>& out) {
+        namespace EiTrace = MorphFixer::Helpers::EiTrace;
+        EiTrace::Trace trace;
+        std::string error;
+        if (!EiTrace::read(in, trace, &error)) {
+            std::fprintf(stderr, "%s: %s\n", path.c_str(), error.c_str());
+            return false;
+        }
+        for (const auto& r : trace.records) {
+            if (r.origin != EiTrace::Origin::kRaceMenu) continue;
+            TraceEvent ev;
+            ev.t_ns = r.t_ns;
+            ev.name = trace.nameOf(r.id);
+            for (std::size_t i = 0; i < std::min<std::size_t>(r.argc, EiTrace::MAX_ARGS); ++i) {
+                ev.args.push_back(r.types[i] == EiTrace::ArgType::kNumber ? std::optional<double>{r.values[i]}
+                                                                          : std::nullopt);
+            }
+            out.push_back(std::move(ev));
+        }
+        return true;
+    }
+
+    bool loadTrace(const std::string& path, std::vector<TraceEvent>& out) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            std::fprintf(stderr, "cannot open %s\n", path.c_str());
+            return false;
+        }
+        std::array<char, 4> magic{};
+        if (in.read(magic.data(), magic.size()) && magic == MorphFixer::Helpers::EiTrace::MAGIC) {
+            in.seekg(0);
+            return loadRecorded(in, path, out);
+        }
+        in.clear();
+        in.seekg(0);
+
+        std::string line;
+        for (int lineNo = 1; std::getline(in, line); ++lineNo) {
+            if (const auto hash = line.find('#'); hash != std::string::npos) line.resize(hash);
+            std::istringstream ss(line);
+            std::string tok;
+            if (!(ss >> tok)) continue;
+
+            TraceEvent ev;
+            const auto t = parseNumber(tok);
+            if (!t || !(ss >> ev.name)) {
+                std::fprintf(stderr, "%s:%d: expected '<time_ms> <name> [args...]'\n", path.c_str(), lineNo);
+                return false;
+            }
+            ev.t_ns = msToNs(*t);
+            while (ss >> tok) ev.args.push_back(parseNumber(tok));
+            out.push_back(std::move(ev));
+        }
+        return true;
+    }
+
+    // --- virtual environment ---
+
+    struct VirtualClock final : CadenceEngine::Clock {
+        long long now{0};
+        [[nodiscard]] long long nowNs() const noexcept override { return now; }
+    };
+
+    // UI tasks and main-thread settles, both run at the next frame
+    struct QueueSink final : CadenceEngine::TaskSink {
+        std::vector<UiCommand> queue;
+        std::vector<UiCommand> settles;
+        long long tailDue{-1};
+
+        bool submit(const UiCommand& cmd) noexcept override {
+            queue.push_back(cmd);
+            return true;
+        }
+        bool submitSettle(const UiCommand& cmd) noexcept override {
+            settles.push_back(cmd);
+            return true;
+        }
+        void armTail(long long dueNs) noexcept override { tailDue = dueNs; }
+        void cancelTail() noexcept override { tailDue = -1; }
+        [[nodiscard]] std::size_t depth() const noexcept override { return queue.size(); }
+    };
+
+    struct FixedWeight final : CadenceEngine::WeightSource {
+        double norm{0.5};
+        [[nodiscard]] double currentNorm() noexcept override { return norm; }
+    };
+
+    struct RecordingDriver final : CadenceEngine::WeightDriver {
+        VirtualClock* clock{nullptr};
+        long long costNs{0};
+        bool verbose{false};
+
+        [[nodiscard]] bool ready() noexcept override { return true; }
+        bool drive(double norm) noexcept override {
+            if (verbose) std::printf("  %10.3f ms  ChangeWeight(%.3f)\n", nsToMs(clock->now), norm);
+            clock->now += costNs;
+            return true;
+        }
+        bool nudgeRestore(double norm, double epsilon) noexcept override {
+            if (verbose) std::printf("  %10.3f ms  ChangeWeight(%.3f +/- %.3f) x2\n", nsToMs(clock->now), norm, epsilon);
+            clock->now += 2 * costNs;
+            return true;
+        }
+        [[nodiscard]] bool canRefresh() noexcept override { return true; }
+        bool refresh() noexcept override {
+            if (verbose) std::printf("  %10.3f ms  SKEE refresh\n", nsToMs(clock->now));
+            clock->now += costNs;
+            return true;
+        }
+        // Traces carry no morph values: every refresh is assumed to be needed
+        [[nodiscard]] bool morphsChanged() noexcept override { return true; }
+    };
+
+    struct Report {
+        std::size_t events{0};
+        CadenceEngine::Stats stats{};
+        long long last_ns{0};
+        int throttle_ms{0};
+        int idle_gap_ms{0};
+
+        using Summary = MorphFixer::Helpers::LogLinearHistogram::Summary;
+        Summary event_to_task, task_to_drive, drive_to_settle, nudge_to_restore, tail_delay, queue_depth;
+    };
+
+    void printLatency(const char* what, const Report::Summary& s) {
+        if (s.count == 0) return;
+        std::printf("  latency %-15s n=%llu p50=%.3f ms p99=%.3f ms max=%.3f ms\n", what,
+                    static_cast<unsigned long long>(s.count), nsToMs(static_cast<long long>(s.p50)),
+                    nsToMs(static_cast<long long>(s.p99)), nsToMs(static_cast<long long>(s.max)));
+    }
+
+    Report replay(const std::vector<TraceEvent>& trace, const Options& opt) {
+        VirtualClock clock;
+        QueueSink sink;
+        FixedWeight weights;
+        RecordingDriver driver;
+        weights.norm = opt.weight;
+        driver.clock = &clock;
+        driver.costNs = msToNs(opt.drive_ms);
+        driver.verbose = opt.verbose;
+
+        CadenceEngine engine(clock, sink, weights, driver);
+        engine.configure(opt.cadence);
+        engine.setRefreshMode(opt.skee ? CadenceEngine::RefreshMode::kSkee : CadenceEngine::RefreshMode::kNudge);
+        engine.setEnabled(true);
+
+        const long long frameNs = std::max<long long>(1, msToNs(opt.frame_ms));
+        const long long meshNs = msToNs(opt.mesh_ms);
+        const auto nextFrame = [&](long long t) { return (t / frameNs + 1) * frameNs; };
+
+        std::size_t next = 0;
+        while (true) {
+            // Candidates: next trace event, next UI frame (if work is queued), tail deadline.
+            constexpr long long NONE = -1;
+            const long long tEvent = next < trace.size() ? std::max(trace[next].t_ns, clock.now) : NONE;
+            const long long tFrame = sink.queue.empty() && sink.settles.empty() ? NONE : nextFrame(clock.now);
+            const long long tTail = sink.tailDue >= 0 ? std::max(sink.tailDue, clock.now) : NONE;
+
+            long long t = NONE;
+            for (const auto c : {tEvent, tFrame, tTail}) {
+                if (c != NONE && (t == NONE || c < t)) t = c;
+            }
+            if (t == NONE) break;
+            clock.now = t;
+
+            if (t == tEvent) {
+                const auto& ev = trace[next++];
+                const auto weight = ev.args.size() >= 2 ? ev.args[1] : std::nullopt;
+                engine.onEvent(ev.name, weight);
+            } else if (t == tTail) {
+                sink.tailDue = -1;
+                engine.onTailTimer();
+                if (opt.verbose && !sink.queue.empty() && sink.queue.back().op == MorphFixer::UiOp::kTail) {
+                    std::printf("  %10.3f ms  tail flush queued\n", nsToMs(clock.now));
+                }
+            } else {
+                // One frame: drain what was queued before it (tasks queued while draining wait a frame).
+                // Each settle runs behind the mesh update its refresh queued.
+                auto settles = std::move(sink.settles);
+                sink.settles.clear();
+                auto batch = std::move(sink.queue);
+                sink.queue.clear();
+                for (const auto& cmd : batch) engine.runTask(cmd);
+                for (const auto& cmd : settles) {
+                    clock.now += meshNs;
+                    engine.runTask(cmd);
+                }
+            }
+        }
+
+        Report r;
+        r.events = trace.size();
+        r.stats = engine.stats();
+        r.last_ns = clock.now;
+        r.throttle_ms = engine.cadence().throttleMs();
+        r.idle_gap_ms = engine.cadence().idleGapMs();
+
+        const auto& lat = engine.latency();
+        r.event_to_task = lat.eventToTask.summary();
+        r.task_to_drive = lat.taskToDrive.summary();
+        r.drive_to_settle = lat.driveToSettle.summary();
+        r.nudge_to_restore = lat.nudgeToRestore.summary();
+        r.tail_delay = lat.tailDelay.summary();
+        r.queue_depth = lat.queueDepth.summary();
+        return r;
+    }
+
+    bool parseArgs(int argc, char** argv, Options& opt, std::vector<std::string>& traces) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view a = argv[i];
+            const auto value = [&](double& out) {
+                if (i + 1 >= argc) return false;
+                const auto v = parseNumber(argv[++i]);
+                if (!v) return false;
+                out = *v;
+                return true;
+            };
+            double v{};
+            if (a == "-v") {
+                opt.verbose = true;
+            } else if (a == "--skee") {
+                opt.skee = true;
+            } else if (a == "--adaptive") {
+                opt.cadence.enabled = true;
+            } else if (a == "--fixed") {
+                opt.cadence.enabled = false;
+            } else if (a == "--frame-ms") {
+                if (!value(opt.frame_ms)) return false;
+            } else if (a == "--drive-ms") {
+                if (!value(opt.drive_ms)) return false;
+            } else if (a == "--mesh-ms") {
+                if (!value(opt.mesh_ms)) return false;
+            } else if (a == "--weight") {
+                if (!value(opt.weight)) return false;
+            } else if (a == "--throttle-ms") {
+                if (!value(v)) return false;
+                opt.cadence.throttle_ms = static_cast<int>(v);
+            } else if (a == "--idle-gap-ms") {
+                if (!value(v)) return false;
+                opt.cadence.idle_gap_ms = static_cast<int>(v);
+            } else if (a.starts_with("-")) {
+                return false;
+            } else {
+                traces.emplace_back(a);
+            }
+        }
+        return !traces.empty();
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    std::vector<std::string> traces;
+    if (!parseArgs(argc, argv, opt, traces)) {
+        std::fprintf(stderr,
+                     "usage: %s [-v] [--skee] [--adaptive|--fixed] [--frame-ms N] [--drive-ms N] [--mesh-ms N] "
+                     "[--weight N] [--throttle-ms N] [--idle-gap-ms N] <trace>...\n",
+                     argv[0]);
+        return 2;
+    }
+
+    int rc = 0;
+    for (const auto& path : traces) {
+        std::vector<TraceEvent> trace;
+        if (!loadTrace(path, trace)) {
+            rc = 1;
+            continue;
+        }
+        std::printf("%s\n", path.c_str());
+        const auto r = replay(trace, opt);
+        const auto& st = r.stats;
+        std::printf("  events=%zu received=%llu throttled=%llu merged=%llu sessions=%llu\n", r.events,
+                    static_cast<unsigned long long>(st.received), static_cast<unsigned long long>(st.throttled),
+                    static_cast<unsigned long long>(st.merged), static_cast<unsigned long long>(st.sessions));
+        std::printf("  changeweight_drives=%llu skee_refreshes=%llu mesh_updates=%llu slider_tasks=%llu "
+                    "tail_flushes=%llu end=%.3f ms\n",
+                    static_cast<unsigned long long>(st.drives), static_cast<unsigned long long>(st.refreshes),
+                    static_cast<unsigned long long>(st.drives + st.refreshes),
+                    static_cast<unsigned long long>(st.executed), static_cast<unsigned long long>(st.tails),
+                    nsToMs(r.last_ns));
+        std::printf("  cadence: throttle=%d ms idle_gap=%d ms\n", r.throttle_ms, r.idle_gap_ms);
+        printLatency("event->task", r.event_to_task);
+        printLatency("task->drive", r.task_to_drive);
+        printLatency("drive->settle", r.drive_to_settle);
+        printLatency("nudge->restore", r.nudge_to_restore);
+        printLatency("tail delay", r.tail_delay);
+        std::printf("  queue depth: p50=%llu p99=%llu max=%llu\n", static_cast<unsigned long long>(r.queue_depth.p50),
+                    static_cast<unsigned long long>(r.queue_depth.p99), static_cast<unsigned long long>(r.queue_depth.max));
+    }
+    return rc;
+}
@@ -0,0 +1,149 @@
+// dispatch_bench: cost of EiDispatch::dispatch per EI callback with 0, 1, 4 and 16 observers.
+//
+// Each callback dispatches a hand-built EiEvent twice, before and after the original, as the
+// proxy does for the routed movie. Observers are added to the real table in steps and split
+// evenly across the two phases (a row holds at most MAX_OBSERVERS), so 16 means 8 + 8. Events
+// cycle through the weight, slider and preset-change classes the game subscribes to. Each
+// observer sums the weight it is given, so every call does a little real work.
+//
+// Exits 1 when an observer is called the wrong number of times or sees the wrong event, or a
+// full row accepts another observer.
+//
+// usage: dispatch_bench [--calls N]
+//   --calls <n>  callbacks per step (default 10000000)
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include <utility>
+
+#include "core/ei_dispatch.h"
+
+namespace {
+    using MorphFixer::EiDispatch;
+    using MorphFixer::EiEvent;
+    using EventClass = MorphFixer::Helpers::EventClassifier::EventClass;
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int MAX_BENCH_OBSERVERS = 16;
+
+    int g_failed = 0;
+
+    void check(bool ok, const char* what) {
+        if (ok) return;
+        if (++g_failed <= 20) std::printf("  CHECK FAILED: %s\n", what);
+    }
+
+    struct ObserverState {
+        std::uint64_t calls{0};
+        std::uint64_t bad{0};
+        double sum{0.0};
+    };
+    std::array<ObserverState, MAX_BENCH_OBSERVERS> g_observers{};
+
+    // Distinct functions, so the walk makes real indirect calls to different targets
+    template <int I>
+    void observe(const EiEvent& ev) {
+        auto& s = g_observers[I];
+        ++s.calls;
+        if (const auto w = ev.number(1)) {
+            s.sum += *w;
+        } else {
+            ++s.bad;
+        }
+    }
+
+    template <int... I>
+    constexpr std::array<EiDispatch::Observer, sizeof...(I)> observerTable(std::integer_sequence<int, I...>) {
+        return {observe<I>...};
+    }
+    constexpr auto OBSERVERS = observerTable(std::make_integer_sequence<int, MAX_BENCH_OBSERVERS>{});
+
+    constexpr EiDispatch::ClassMask SUBSCRIBED = EiDispatch::maskOf(EventClass::kWeight) |
+                                                 EiDispatch::maskOf(EventClass::kSlider) |
+                                                 EiDispatch::maskOf(EventClass::kPresetChange);
+
+    // What the proxy decodes from RaceMenu's ChangeWeight(arg0, weight, 2) and friends
+    std::array<EiEvent, 3> makeEvents() {
+        std::array<EiEvent, 3> evs{};
+        const std::array<std::pair<const char*, EventClass>, 3> src{{{"ChangeWeight", EventClass::kWeight},
+                                                                     {"ChangeDoubleMorph", EventClass::kSlider},
+                                                                     {"ChangePreset", EventClass::kPresetChange}}};
+        for (std::size_t i = 0; i < evs.size(); ++i) {
+            auto& ev = evs[i];
+            ev.name = src[i].first;
+            ev.id = static_cast<MorphFixer::Helpers::EventNames::EventId>(i + 1);
+            ev.cls = src[i].second;
+            ev.argc = 3;
+            ev.num = {1.0, 0.25 * static_cast<double>(i + 1), 2.0, 0.0};
+            ev.numericMask = 0b111;
+        }
+        return evs;
+    }
+
+    bool parseArgs(int argc, char** argv, long long& calls) {
+        for (int i = 1; i + 1 < argc; i += 2) {
+            const std::string_view a = argv[i];
+            if (a == "--calls") {
+                calls = std::atoll(argv[i + 1]);
+            } else {
+                return false;
+            }
+        }
+        return argc % 2 == 1 && calls > 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    long long calls = 10000000;
+    if (!parseArgs(argc, argv, calls)) {
+        std::fprintf(stderr, "usage: %s [--calls N]\n", argv[0]);
+        return 2;
+    }
+    static_assert(MAX_BENCH_OBSERVERS == 2 * EiDispatch::MAX_OBSERVERS, "16 observers fill both phases");
+
+    auto& d = EiDispatch::get();
+    const auto events = makeEvents();
+    std::printf("%lld callbacks per step, two dispatches each (before/after original)\n", calls);
+
+    int subscribed = 0;
+    double baseNs = 0.0;
+    for (const int observers : {0, 1, 4, 16}) {
+        for (; subscribed < observers; ++subscribed) {
+            const auto phase = subscribed % 2 ? EiDispatch::Phase::kAfterOriginal : EiDispatch::Phase::kBeforeOriginal;
+            check(d.subscribe(phase, SUBSCRIBED, OBSERVERS[subscribed]), "subscribe");
+        }
+        for (auto& s : g_observers) s = {};
+
+        const auto t0 = Clock::now();
+        for (long long i = 0; i < calls; ++i) {
+            const auto& ev = events[static_cast<std::size_t>(i % 3)];
+            d.dispatch(EiDispatch::Phase::kBeforeOriginal, ev);
+            d.dispatch(EiDispatch::Phase::kAfterOriginal, ev);
+        }
+        const double ns =
+            std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / static_cast<double>(calls);
+        if (observers == 0) baseNs = ns;
+
+        std::printf("%2d observers  %6.2f ns/callback", observers, ns);
+        if (observers) std::printf("  %5.2f ns/observer call", (ns - baseNs) / observers);
+        std::printf("\n");
+
+        for (int i = 0; i < MAX_BENCH_OBSERVERS; ++i) {
+            const auto& s = g_observers[static_cast<std::size_t>(i)];
+            check(s.calls == (i < observers ? static_cast<std::uint64_t>(calls) : 0), "observer call count");
+            check(s.bad == 0, "observer saw an event without its weight");
+        }
+    }
+
+    // Both rows are full now
+    check(!d.subscribe(EiDispatch::Phase::kBeforeOriginal, SUBSCRIBED, OBSERVERS[0]), "full row accepted");
+    check(d.subscribe(EiDispatch::Phase::kBeforeOriginal, EiDispatch::maskOf(EventClass::kUnknown), OBSERVERS[0]),
+          "row of another class refused");
+
+    if (g_failed) std::printf("FAILED (%d checks)\n", g_failed);
+    return g_failed ? 1 : 0;
+}
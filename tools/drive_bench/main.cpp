@@ -0,0 +1,261 @@
+// drive_bench: drives/sec and heap allocations per drive for the prepared ChangeWeight template
+// (DriveTemplate), against the per-drive rebuild it replaced, on a stand-in for RE::GFxValue.
+//
+//   template - DriveTemplate::prepare patches arg0/arg1 and reuses everything else; rebuilt only
+//              when RaceMenu's call shape changes (--reshape)
+//   rebuild  - the old path: a std::vector of values filled from the snapshot, under a mutex,
+//              on every drive
+//
+// Both feed the same sink, which checks every drive's arguments against the snapshot they were
+// built from. Allocations are counted with Helpers::Alloc (the counting operator new). Exits 1
+// when a drive's arguments are wrong, the template rebuilds more often than the shape changes,
+// or the template path allocates after its first drive.
+//
+// usage: drive_bench [--drives N] [--reshape N] [--args N]
+//   --drives <n>   drives per run (default 2000000)
+//   --reshape <n>  RaceMenu sends a call with a new shape every n drives (default 1000; 0 = never)
+//   --args <n>     arguments in RaceMenu's ChangeWeight, 2..8 (default 3)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include "core/drive_template.h"
+#include "helpers/alloc_counter.h"
+
+namespace {
+    using MorphFixer::ArgCopy;
+    using MorphFixer::ArgSnapshot;
+    using MorphFixer::ArgSnapshotCell;
+    using MorphFixer::DriveTemplate;
+    using Clock = std::chrono::steady_clock;
+
+    static_assert(MorphFixer::Helpers::Alloc::COUNTING, "link rmf_alloc_counter (it defines RMF_COUNT_ALLOCS)");
+
+    // Layout and setters of RE::GFxValue (interface pointer, type, 8-byte payload). Like the
+    // real one, SetString stores the pointer and copies nothing.
+    struct FakeValue {
+        enum class Type : std::uint32_t { kUndefined, kBoolean, kNumber, kString };
+
+        [[nodiscard]] bool IsNumber() const { return type == Type::kNumber; }
+        [[nodiscard]] bool IsBool() const { return type == Type::kBoolean; }
+        [[nodiscard]] bool IsString() const { return type == Type::kString; }
+        [[nodiscard]] double GetNumber() const { return value.num; }
+        [[nodiscard]] bool GetBool() const { return value.b; }
+        [[nodiscard]] const char* GetString() const { return value.str; }
+
+        void SetNumber(double v) {
+            type = Type::kNumber;
+            value.num = v;
+        }
+        void SetBoolean(bool v) {
+            type = Type::kBoolean;
+            value.b = v;
+        }
+        void SetString(const char* v) {
+            type = Type::kString;
+            value.str = v;
+        }
+        void SetUndefined() { type = Type::kUndefined; }
+
+        void* objectInterface{nullptr};
+        Type type{Type::kUndefined};
+        union {
+            double num;
+            bool b;
+            const char* str;
+        } value{0.0};
+    };
+
+    struct Options {
+        int drives{2000000};
+        int reshape{1000};
+        int args{3};
+    };
+
+    int g_failed = 0;
+
+    void check(bool ok, const char* what) {
+        if (ok) return;
+        if (++g_failed <= 20) std::printf("  CHECK FAILED: %s\n", what);
+    }
+
+    // RaceMenu's own ChangeWeight(arg0, weight, 2, ...): args 2+ alternate number/string/bool,
+    // and the string carries the shape generation so each reshape really changes the shape.
+    struct NativeCall {
+        std::vector<FakeValue> args;
+        char label[32]{};
+
+        void build(int argc, int generation) {
+            std::snprintf(label, sizeof(label), "body_%d", generation);
+            args.assign(static_cast<std::size_t>(argc), FakeValue{});
+            args[0].SetNumber(1.0);
+            args[1].SetNumber(0.5);
+            for (int i = 2; i < argc; ++i) {
+                if (i % 3 == 2) args[i].SetNumber(2.0);
+                if (i % 3 == 0) args[i].SetString(label);
+                if (i % 3 == 1) args[i].SetBoolean(true);
+            }
+        }
+    };
+
+    // Stands in for the EI call: checks the drive against the snapshot it came from
+    struct Sink {
+        ArgSnapshot expect{};
+        std::uint64_t calls{0};
+        std::uint64_t bad{0};
+
+        void call(const FakeValue* args, std::uint32_t argc, double arg0, double norm) {
+            ++calls;
+            bool ok = argc == expect.argc && args[0].IsNumber() && args[0].GetNumber() == arg0 &&
+                      args[1].IsNumber() && args[1].GetNumber() == norm;
+            for (std::uint32_t i = 2; ok && i < argc; ++i) {
+                const auto got = ArgCopy::from(args[i]);
+                const auto& want = expect.args[i];
+                ok = got.t == want.t && got.num == want.num && got.b == want.b &&
+                     std::strcmp(got.s.data(), want.s.data()) == 0;
+            }
+            bad += !ok;
+        }
+    };
+
+    // The pre-template driver: copy out the snapshot and rebuild a vector of values per drive
+    struct RebuildDriver {
+        std::mutex mu;
+        ArgSnapshot snap{};
+
+        void store(const FakeValue* args, std::uint32_t argc) {
+            std::lock_guard lk(mu);
+            snap.argc = std::min(argc, ArgSnapshot::MAX_ARGS);
+            for (std::uint32_t i = 0; i < snap.argc; ++i) snap.args[i] = ArgCopy::from(args[i]);
+        }
+
+        void drive(Sink& sink, double arg0, double norm) {
+            std::vector<FakeValue> callArgs;
+            {
+                std::lock_guard lk(mu);
+                callArgs.resize(snap.argc);
+                for (std::uint32_t i = 0; i < snap.argc; ++i) snap.args[i].toValue(callArgs[i]);
+                callArgs[1].SetNumber(std::clamp(norm, 0.0, 1.0));
+                callArgs[0].SetNumber(arg0);
+            }
+            sink.call(callArgs.data(), static_cast<std::uint32_t>(callArgs.size()), arg0, norm);
+        }
+    };
+
+    struct Result {
+        double seconds{0};
+        std::uint64_t allocs{0};
+        std::uint64_t warmAllocs{0};  // after each reshape's first drive
+        std::uint64_t rebuilds{0};
+        std::uint64_t bad{0};
+    };
+
+    double normFor(int i) { return static_cast<double>(i % 1000) / 1000.0; }
+
+    template <class Drive, class Store>
+    Result run(const Options& opt, Store&& store, Drive&& drive, Sink& sink) {
+        NativeCall native;
+        int generation = 0;
+        native.build(opt.args, generation);
+        store(native);
+
+        Result r;
+        const auto t0 = Clock::now();
+        for (int i = 0; i < opt.drives; ++i) {
+            const bool reshaped = opt.reshape > 0 && i > 0 && i % opt.reshape == 0;
+            if (reshaped) {
+                native.build(opt.args, ++generation);
+                store(native);
+            }
+            const auto before = MorphFixer::Helpers::Alloc::threadCount();
+            drive(static_cast<double>(i + 1), normFor(i));
+            const auto n = MorphFixer::Helpers::Alloc::threadCount() - before;
+            r.allocs += n;
+            if (i > 0 && !reshaped) r.warmAllocs += n;
+        }
+        r.seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+        r.bad = sink.bad;
+        return r;
+    }
+
+    void print(const char* name, const Result& r, const Options& opt) {
+        std::printf("%-9s %7.2f M drives/s  %6.1f ns/drive  %.3f allocs/drive", name, opt.drives / r.seconds / 1e6,
+                    r.seconds * 1e9 / opt.drives, static_cast<double>(r.allocs) / opt.drives);
+        if (r.rebuilds) std::printf("  rebuilds=%llu", static_cast<unsigned long long>(r.rebuilds));
+        std::printf("\n");
+    }
+
+    bool parseArgs(int argc, char** argv, Options& opt) {
+        for (int i = 1; i + 1 < argc; i += 2) {
+            const std::string_view a = argv[i];
+            const int v = std::atoi(argv[i + 1]);
+            if (a == "--drives") {
+                opt.drives = v;
+            } else if (a == "--reshape") {
+                opt.reshape = v;
+            } else if (a == "--args") {
+                opt.args = v;
+            } else {
+                return false;
+            }
+        }
+        return argc % 2 == 1 && opt.drives > 0 && opt.reshape >= 0 && opt.args >= 2 &&
+               opt.args <= static_cast<int>(ArgSnapshot::MAX_ARGS);
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        std::fprintf(stderr, "usage: %s [--drives N] [--reshape N] [--args 2..8]\n", argv[0]);
+        return 2;
+    }
+    std::printf("%d drives, %d-arg ChangeWeight, reshaped every %d drives, %zu-byte value\n", opt.drives,
+                opt.args, opt.reshape, sizeof(FakeValue));
+
+    // Template path: the cell and template the driver uses, on the stand-in value
+    ArgSnapshotCell cell;
+    auto tmpl = std::make_unique<DriveTemplate<FakeValue>>();
+    Sink tmplSink;
+    auto t = run(
+        opt,
+        [&](const NativeCall& c) {
+            cell.store(c.args.data(), static_cast<std::uint32_t>(c.args.size()));
+            cell.load(tmplSink.expect);
+        },
+        [&](double arg0, double norm) {
+            const auto n = tmpl->prepare(cell, arg0, norm);
+            tmplSink.call(tmpl->args.data(), n, arg0, norm);
+        },
+        tmplSink);
+    t.rebuilds = tmpl->rebuilds;
+    print("template", t, opt);
+
+    RebuildDriver old;
+    Sink oldSink;
+    const auto o = run(
+        opt,
+        [&](const NativeCall& c) {
+            old.store(c.args.data(), static_cast<std::uint32_t>(c.args.size()));
+            oldSink.expect = old.snap;
+        },
+        [&](double arg0, double norm) { old.drive(oldSink, arg0, norm); }, oldSink);
+    print("rebuild", o, opt);
+
+    const auto shapes = 1 + (opt.reshape ? static_cast<std::uint64_t>((opt.drives - 1) / opt.reshape) : 0);
+    check(t.bad == 0 && tmplSink.calls == static_cast<std::uint64_t>(opt.drives), "template drive arguments");
+    check(o.bad == 0, "rebuild drive arguments");
+    check(t.rebuilds <= shapes, "template rebuilt without a shape change");
+    check(t.warmAllocs == 0, "template path allocated after warm-up");
+
+    if (g_failed) std::printf("FAILED (%d checks)\n", g_failed);
+    return g_failed ? 1 : 0;
+}
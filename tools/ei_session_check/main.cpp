@@ -0,0 +1,323 @@
+// ei_session_check: AddRef/Release pairing of ExternalInterfaceRef, EiSession and the proxy
+// registry, against a counting fake EI and a fake movie whose state bag behaves like GFx (SetState
+// takes a reference on the new state and drops the old one; GetStateAddRef hands one out).
+//
+//   ref      - adopt takes no reference, retain takes one, moves transfer, reset/dtor release
+//   adopt    - the drive fallback: lookupOr outside a session takes the state with GetStateAddRef
+//              and releases it with the fallback ref; inside one it touches no counts
+//   session  - open pins one reference, a second open closes the first, close releases, the
+//              generation is odd exactly while open
+//   registry - install/remove on routed and observed movies, for --cycles menu sessions: every
+//              count returns to its starting value after each remove, the routed movie's proxy is
+//              pinned while installed, a second install flips the route and the pin with it, and
+//              no proxy is created after the first session
+//   stale    - a proxied movie destroyed without remove() and a new one built at its address: the
+//              next install reclaims the slot, releases the old original and proxies the new movie
+//   full     - a movie past the last slot is refused with its counts untouched
+//
+// Exits 1 on any mismatch.
+//
+// usage: ei_session_check [--cycles N]
+//   --cycles <n>  menu sessions in the registry run (default 1000)
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "core/ei_proxy_registry.h"
+#include "core/ei_session.h"
+
+namespace {
+    using MorphFixer::BasicEiSession;
+    using MorphFixer::BasicExternalInterfaceRef;
+    using MorphFixer::EiProxyRegistry;
+
+    int g_failed = 0;
+
+    void check(bool ok, const char* what) {
+        if (ok) return;
+        if (++g_failed <= 20) std::printf("  CHECK FAILED: %s\n", what);
+    }
+
+    // Starts at one reference, like GFx's RefCountBase. Never deleted, so a count that drops below
+    // zero is reported instead of crashing.
+    struct FakeEI {
+        virtual ~FakeEI() = default;
+
+        void AddRef() noexcept {
+            ++refs;
+            ++s_addRefs;
+        }
+        void Release() noexcept {
+            if (--refs < 0) ++s_underflows;
+            ++s_releases;
+        }
+
+        int refs{1};
+
+        static inline std::uint64_t s_addRefs = 0;
+        static inline std::uint64_t s_releases = 0;
+        static inline std::uint64_t s_underflows = 0;
+    };
+
+    using Ref = BasicExternalInterfaceRef<FakeEI>;
+
+    struct FakeProxy : FakeEI {
+        FakeProxy() { ++s_created; }
+
+        void bind(Ref orig, bool route) noexcept {
+            m_orig = std::move(orig);
+            m_route = route;
+        }
+        void unbind() noexcept {
+            m_route = false;
+            m_orig.reset();
+        }
+        void setRoute(bool route) noexcept { m_route = route; }
+        [[nodiscard]] FakeEI* original() const noexcept { return m_orig.get(); }
+        [[nodiscard]] bool isRouted() const noexcept { return m_route; }
+
+        static inline int s_created = 0;
+
+    private:
+        Ref m_orig;
+        bool m_route{false};
+    };
+
+    // State bag with the one state that matters; holds a reference on it like GFxStateBag.
+    struct FakeMovie {
+        explicit FakeMovie(FakeEI* ei) : state(ei) {
+            if (state) state->AddRef();
+        }
+        ~FakeMovie() {
+            if (state) state->Release();
+        }
+
+        FakeEI* GetStateAddRef() {
+            ++stateLookups;
+            if (state) state->AddRef();
+            return state;
+        }
+        void SetState(FakeEI* ei) {
+            if (ei) ei->AddRef();
+            if (state) state->Release();
+            state = ei;
+        }
+
+        FakeEI* state;
+        int stateLookups{0};
+    };
+
+    struct FakeTraits {
+        using Movie = FakeMovie;
+        using EI = FakeEI;
+        using Proxy = FakeProxy;
+
+        static EI* stateAddRef(Movie* mv) { return mv->GetStateAddRef(); }
+        static void setState(Movie* mv, EI* ei) { mv->SetState(ei); }
+    };
+
+    using Session = BasicEiSession<FakeMovie, FakeEI>;
+    using Registry = EiProxyRegistry<FakeTraits, 4>;
+
+    void checkRef() {
+        FakeEI ei;  // 1: the creator's
+        {
+            auto a = Ref::adopt(&ei);  // takes over the creator's
+            check(ei.refs == 1, "adopt took a reference");
+            auto b = Ref::retain(&ei);
+            check(ei.refs == 2, "retain did not take a reference");
+            Ref c = std::move(b);
+            check(ei.refs == 2 && !b && c.get() == &ei, "move changed the count");
+            c = std::move(a);  // drops c's old reference, takes a's
+            check(ei.refs == 1 && !a, "move-assign did not release the old reference");
+            c.reset();
+            check(ei.refs == 0 && !c, "reset did not release");
+            c.reset();
+            check(ei.refs == 0, "second reset released again");
+        }
+        check(ei.refs == 0, "destructor released an empty ref");
+        ei.refs = 1;
+        { auto r = Ref::retain(&ei); }
+        check(ei.refs == 1, "destructor did not release");
+        { auto r = Ref::retain(nullptr); check(!r, "retain(nullptr) is empty"); }
+    }
+
+    void checkAdopt() {
+        FakeEI orig;
+        FakeMovie mv(&orig);  // orig: creator + movie
+        Session session;
+
+        {
+            Ref fallback;
+            auto* ei = session.lookupOr(&mv, fallback, FakeTraits::stateAddRef);
+            check(ei == &orig && fallback.get() == &orig, "fallback did not take the movie's EI");
+            check(orig.refs == 3, "fallback lookup did not add-ref");
+        }
+        check(orig.refs == 2, "fallback ref not released");
+
+        FakeEI pinned;
+        session.open(&mv, Ref::retain(&pinned));
+        const int lookups = mv.stateLookups;
+        {
+            Ref fallback;
+            auto* ei = session.lookupOr(&mv, fallback, FakeTraits::stateAddRef);
+            check(ei == &pinned && !fallback, "pinned lookup fell back");
+            check(mv.stateLookups == lookups && pinned.refs == 2, "pinned lookup touched counts");
+        }
+        session.close();
+        check(pinned.refs == 1 && orig.refs == 2, "adopt path unbalanced");
+
+        Ref none;
+        check(!session.lookupOr(nullptr, none, FakeTraits::stateAddRef) && !none, "null movie");
+    }
+
+    void checkSession() {
+        FakeEI a, b;
+        FakeMovie ma(&a), mb(&b);
+        Session session;
+
+        check(session.generation() == 0 && !session.lookup(&ma), "fresh session");
+        check(session.open(&ma, Ref::retain(&a)) == 1, "first open generation");
+        check(a.refs == 3 && session.lookup(&ma) == &a && !session.lookup(&mb), "open pins one reference");
+        check(session.open(&mb, Ref::retain(&b)) == 3, "reopen generation");
+        check(a.refs == 2 && b.refs == 3, "reopen did not release the first session");
+        check(session.lookup(&mb) == &b && !session.lookup(&ma), "reopen lookup");
+        check(session.close() == 4 && b.refs == 2 && !session.lookup(&mb), "close");
+        check(session.close() == 0 && b.refs == 2, "second close");
+        check(session.open(&ma, Ref{}) == 0 && session.generation() == 4, "open with no EI");
+        check(session.open(nullptr, Ref::retain(&a)) == 0, "open with no movie");
+        check(a.refs == 2, "refused open kept its reference");  // checked after the argument is gone
+    }
+
+    void checkRegistry(int cycles) {
+        // Movie 0 is routed (RaceMenu), the others only observed
+        std::vector<FakeEI> origs(3);
+        std::vector<FakeMovie*> movies;
+        for (auto& o : origs) movies.push_back(new FakeMovie(&o));
+        Registry registry;
+        Session session;
+
+        for (int c = 0; c < cycles; ++c) {
+            for (std::size_t i = 0; i < movies.size(); ++i) {
+                const bool route = i == 0;
+                check(registry.install(movies[i], route, session) == Registry::Install::kInstalled, "install");
+                auto* proxy = registry.lookup(movies[i])->proxy;
+                check(movies[i]->state == proxy && proxy->original() == &origs[i], "proxy not installed");
+                check(proxy->isRouted() == route, "route flag");
+                // orig: creator + proxy; proxy: registry + movie (+ session when routed)
+                check(origs[i].refs == 2, "orig count while installed");
+                check(proxy->refs == (route ? 3 : 2), "proxy count while installed");
+                check((session.lookup(movies[i]) == proxy) == route, "session pin");
+                check(registry.install(movies[i], route, session) == Registry::Install::kAlreadyInstalled,
+                      "second install");
+
+                // Re-enable with the other route: the flag and the session pin follow, counts stay paired
+                check(registry.install(movies[i], !route, session) == Registry::Install::kRerouted, "reroute");
+                check(proxy->isRouted() == !route && (session.lookup(movies[i]) == proxy) == !route,
+                      "reroute flag / pin");
+                check(proxy->refs == (route ? 2 : 3) && origs[i].refs == 2, "proxy count after reroute");
+                check(registry.install(movies[i], route, session) == Registry::Install::kRerouted, "route back");
+                check(proxy->isRouted() == route && proxy->refs == (route ? 3 : 2), "route back flag / count");
+            }
+            for (std::size_t i = 0; i < movies.size(); ++i) {
+                auto* proxy = registry.remove(movies[i], session);
+                check(proxy && movies[i]->state == &origs[i], "remove did not restore the original");
+                check(origs[i].refs == 2 && proxy->refs == 1, "remove unbalanced");
+                check(!registry.lookup(movies[i]) && !registry.remove(movies[i], session), "slot not freed");
+            }
+            check(!(session.generation() & 1), "session left open");
+        }
+        check(FakeProxy::s_created == static_cast<int>(movies.size()), "proxies created after warm-up");
+
+        for (auto* m : movies) delete m;
+        for (auto& o : origs) check(o.refs == 1, "movie teardown unbalanced");
+    }
+
+    void checkStale() {
+        FakeEI oldOrig, newOrig;
+        alignas(FakeMovie) unsigned char storage[sizeof(FakeMovie)];
+        Registry registry;
+        Session session;
+
+        auto* mv = new (storage) FakeMovie(&oldOrig);
+        check(registry.install(mv, true, session) == Registry::Install::kInstalled, "stale: first install");
+        auto* proxy = registry.lookup(mv)->proxy;
+
+        // Torn down without remove(): the movie drops its reference on the proxy, nothing else
+        mv->~FakeMovie();
+        mv = new (storage) FakeMovie(&newOrig);
+        check(registry.lookup(mv) != nullptr, "stale: slot should still claim the address");
+
+        check(registry.install(mv, true, session) == Registry::Install::kInstalled, "stale slot not reclaimed");
+        check(mv->state == proxy && proxy->original() == &newOrig && session.lookup(mv) == proxy,
+              "stale: new movie not proxied");
+        check(oldOrig.refs == 1, "stale: old original still held");
+        check(newOrig.refs == 2 && proxy->refs == 3, "stale: counts after reclaim");
+
+        // Same again, but the new movie has no EI: refused, and the slot is freed all the same
+        mv->~FakeMovie();
+        mv = new (storage) FakeMovie(nullptr);
+        check(registry.install(mv, false, session) == Registry::Install::kNoInterface, "stale: no EI accepted");
+        check(!registry.lookup(mv) && !(session.generation() & 1), "stale: slot or pin kept");
+        check(newOrig.refs == 1 && proxy->refs == 1, "stale: counts after refused reclaim");
+        mv->~FakeMovie();
+    }
+
+    void checkFull() {
+        std::vector<FakeEI> origs(Registry::MAX_MOVIES + 1);
+        std::vector<FakeMovie*> movies;
+        for (auto& o : origs) movies.push_back(new FakeMovie(&o));
+        Registry registry;
+        Session session;
+
+        for (std::size_t i = 0; i < Registry::MAX_MOVIES; ++i) {
+            check(registry.install(movies[i], false, session) == Registry::Install::kInstalled, "fill");
+        }
+        auto* last = movies.back();
+        check(registry.install(last, false, session) == Registry::Install::kFull, "full registry accepted");
+        check(last->state == &origs.back() && origs.back().refs == 2, "refused install touched counts");
+        for (std::size_t i = 0; i < Registry::MAX_MOVIES; ++i) registry.remove(movies[i], session);
+        for (auto& o : origs) check(o.refs == 2, "full run unbalanced");
+        for (auto* m : movies) delete m;
+    }
+
+    bool parseArgs(int argc, char** argv, int& cycles) {
+        for (int i = 1; i + 1 < argc; i += 2) {
+            const std::string_view a = argv[i];
+            if (a == "--cycles") {
+                cycles = std::atoi(argv[i + 1]);
+            } else {
+                return false;
+            }
+        }
+        return argc % 2 == 1 && cycles > 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    int cycles = 1000;
+    if (!parseArgs(argc, argv, cycles)) {
+        std::fprintf(stderr, "usage: %s [--cycles N]\n", argv[0]);
+        return 2;
+    }
+
+    checkRef();
+    checkAdopt();
+    checkSession();
+    const auto addRefs = FakeEI::s_addRefs, releases = FakeEI::s_releases;
+    checkRegistry(cycles);
+    std::printf("%d registry cycles: %llu AddRef, %llu Release, %d proxies created\n", cycles,
+                static_cast<unsigned long long>(FakeEI::s_addRefs - addRefs),
+                static_cast<unsigned long long>(FakeEI::s_releases - releases), FakeProxy::s_created);
+    checkStale();
+    checkFull();
+    check(FakeEI::s_underflows == 0, "a count dropped below zero");
+
+    if (g_failed) std::printf("FAILED (%d checks)\n", g_failed);
+    return g_failed ? 1 : 0;
+}
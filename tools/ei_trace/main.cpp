@@ -0,0 +1,96 @@
+// ei_trace: prints EiRecorder session dumps (*.rmft) as text.
+//
+// usage: ei_trace [--all] <file.rmft>...
+//   Output is cadence_replay's text trace format: '<time_ms> <name> [args...]'. Calls issued by
+//   our own driver are printed as '#driver' comment lines (or as plain lines with --all), so the
+//   output can be edited and fed straight back into cadence_replay.
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/ei_trace_format.h"
+
+namespace {
+    namespace EiTrace = MorphFixer::Helpers::EiTrace;
+
+    void printArg(EiTrace::ArgType type, double value) {
+        switch (type) {
+            case EiTrace::ArgType::kNumber:
+                std::printf(" %.6g", value);
+                break;
+            case EiTrace::ArgType::kBool:
+                std::printf(" %s", value != 0.0 ? "true" : "false");
+                break;
+            case EiTrace::ArgType::kNull:
+                std::printf(" null");
+                break;
+            case EiTrace::ArgType::kString:
+                std::printf(" <str>");
+                break;
+            case EiTrace::ArgType::kOther:
+                std::printf(" <obj>");
+                break;
+            default:
+                std::printf(" undefined");
+                break;
+        }
+    }
+
+    bool dump(const std::string& path, bool all) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            std::fprintf(stderr, "cannot open %s\n", path.c_str());
+            return false;
+        }
+        EiTrace::Trace trace;
+        std::string error;
+        if (!EiTrace::read(in, trace, &error)) {
+            std::fprintf(stderr, "%s: %s\n", path.c_str(), error.c_str());
+            return false;
+        }
+
+        std::size_t driver = 0;
+        for (const auto& r : trace.records) driver += (r.origin == EiTrace::Origin::kDriver);
+        std::printf("# %s: %zu records (%zu from our driver), %llu lost, %zu names\n", path.c_str(),
+                    trace.records.size(), driver, static_cast<unsigned long long>(trace.lost), trace.names.size());
+
+        for (const auto& r : trace.records) {
+            const bool fromDriver = r.origin == EiTrace::Origin::kDriver;
+            if (fromDriver && !all) std::printf("#driver ");
+            const auto name = trace.nameOf(r.id);
+            std::printf("%.3f %.*s", static_cast<double>(r.t_ns) / 1e6, static_cast<int>(name.size()), name.data());
+            const auto n = std::min<std::size_t>(r.argc, EiTrace::MAX_ARGS);
+            for (std::size_t i = 0; i < n; ++i) printArg(r.types[i], r.values[i]);
+            if (r.argc > EiTrace::MAX_ARGS) std::printf(" # argc=%u", static_cast<unsigned>(r.argc));
+            std::printf("\n");
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    bool all = false;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view a = argv[i];
+        if (a == "--all") {
+            all = true;
+        } else {
+            files.emplace_back(a);
+        }
+    }
+    if (files.empty()) {
+        std::fprintf(stderr, "usage: %s [--all] <file.rmft>...\n", argv[0]);
+        return 2;
+    }
+
+    int rc = 0;
+    for (const auto& f : files) {
+        if (!dump(f, all)) rc = 1;
+    }
+    return rc;
+}
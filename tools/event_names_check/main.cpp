@@ -0,0 +1,249 @@
+// event_names_check: checks the EI event classifier and EventNames interning against plain
+// reference versions (a linear scan of the vocabulary, a std::unordered_map) and reports what a
+// resolve() costs.
+//
+//   classify - vocabulary names in random letter case, plus near misses (a letter dropped, added
+//             or changed), through classifyKnown / classifyFallback / resolve vs a linear scan
+//             and the substring rules written out with std::search
+//   intern  - several threads resolve the same runtime (non-vocabulary) names concurrently; every
+//             thread must get the same id for a name, different names different ids, and nameOf /
+//             classOf must give the name and class back
+//
+// Exits 1 on any mismatch.
+//
+// usage: event_names_check [--threads N] [--names N] [--iters N] [--cases N]
+//   --threads <n>  resolving threads (default 8)
+//   --names <n>    runtime names interned (default 120, the table holds 256)
+//   --iters <n>    resolve() calls per timing (default 1000000)
+//   --cases <n>    random names classified (default 20000)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "core/ei_event_names.h"
+
+namespace {
+    namespace EventClassifier = MorphFixer::Helpers::EventClassifier;
+    namespace EventNames = MorphFixer::Helpers::EventNames;
+    using EventClass = EventClassifier::EventClass;
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        int threads{8};
+        int names{120};
+        int iters{1000000};
+        int cases{20000};
+    };
+
+    int g_failed = 0;
+
+    void check(bool ok, const char* what) {
+        if (ok) return;
+        std::printf("  CHECK FAILED: %s\n", what);
+        ++g_failed;
+    }
+
+    template <class Fn>
+    double nsPerCall(int iters, Fn&& fn) {
+        const auto t0 = Clock::now();
+        for (int i = 0; i < iters; ++i) fn(i);
+        return std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / iters;
+    }
+
+    // Reference classifier: no shared helpers, just the rules spelled out.
+    bool foldEq(char a, char b) {
+        const auto la = (a >= 'A' && a <= 'Z') ? static_cast<char>(a - 'A' + 'a') : a;
+        const auto lb = (b >= 'A' && b <= 'Z') ? static_cast<char>(b - 'A' + 'a') : b;
+        return la == lb;
+    }
+
+    bool refContains(std::string_view hay, std::string_view needle) {
+        return std::search(hay.begin(), hay.end(), needle.begin(), needle.end(), foldEq) != hay.end();
+    }
+
+    int refIndex(std::string_view name) {
+        for (std::size_t i = 0; i < EventClassifier::VOCABULARY_SIZE; ++i) {
+            const auto v = EventClassifier::VOCABULARY[i].name;
+            if (v.size() == name.size() && std::equal(v.begin(), v.end(), name.begin(), foldEq)) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    constexpr std::string_view CHANGE = "Change";  // matched case-sensitively, unlike "preset"
+
+    EventClass refClassify(std::string_view name) {
+        if (const auto i = refIndex(name); i >= 0) return EventClassifier::VOCABULARY[i].cls;
+        const bool hasChange = std::search(name.begin(), name.end(), CHANGE.begin(), CHANGE.end()) != name.end();
+        if (refContains(name, "preset")) {
+            return hasChange ? EventClass::kPresetChange : EventClass::kPreset;
+        }
+        return hasChange ? EventClass::kSlider : EventClass::kUnknown;
+    }
+
+    std::string_view vocabName(int i) {
+        return EventClassifier::VOCABULARY[static_cast<std::size_t>(i) % EventClassifier::VOCABULARY_SIZE].name;
+    }
+
+    std::string mutate(std::string s, unsigned& r) {
+        constexpr std::string_view ALPHABET = "aAeEgGhHpPtTzZ_";
+        const auto next = [&r] { return r = r * 1664525u + 1013904223u, r >> 8; };
+        for (auto& c : s) {
+            if (next() & 1) c = (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+        }
+        switch (next() % 4) {
+            case 0:
+                break;  // only the case changed: must still match
+            case 1:
+                s.erase(next() % s.size(), 1);
+                break;
+            case 2:
+                s.insert(next() % (s.size() + 1), 1, ALPHABET[next() % ALPHABET.size()]);
+                break;
+            default:
+                s[next() % s.size()] = ALPHABET[next() % ALPHABET.size()];
+                break;
+        }
+        return s;
+    }
+
+    void checkClassify(const Options& opt) {
+        std::vector<std::string> names;
+        for (const auto& e : EventClassifier::VOCABULARY) names.emplace_back(e.name);
+        for (const auto extra : {"ChangeSkinColor", "PresetLoaded", "changepresetslot", "OnMenuOpen", "Preset",
+                                 "change", "CHANGESKIN", "MyChangeSlot", "", "SetSliderValue"}) {
+            names.emplace_back(extra);
+        }
+        unsigned r = 0xC0FFEEu;
+        for (int i = 0; i < opt.cases; ++i) {
+            names.push_back(mutate(std::string(vocabName(i)), r));
+        }
+
+        std::size_t known = 0, indexErrors = 0, fallbackErrors = 0, resolveErrors = 0;
+        for (const auto& n : names) {
+            const auto ref = refIndex(n);
+            if (ref >= 0) ++known;
+            if (EventClassifier::vocabularyIndex(n) != ref) ++indexErrors;
+            if (EventClassifier::classifyFallback(n) != refClassify(n)) ++fallbackErrors;
+            // Only vocabulary names: runtime names would fill the intern table
+            if (ref >= 0) {
+                const auto info = EventNames::resolve(n);
+                if (info.id != ref + 1 || info.cls != EventClassifier::VOCABULARY[ref].cls) ++resolveErrors;
+            }
+        }
+        std::printf("classify: %zu name(s), %zu in the vocabulary; mismatches index=%zu fallback=%zu resolve=%zu\n",
+                    names.size(), known, indexErrors, fallbackErrors, resolveErrors);
+        check(indexErrors == 0, "vocabularyIndex matches the linear scan");
+        check(fallbackErrors == 0, "classifyFallback matches the reference rules");
+        check(resolveErrors == 0, "resolve gives vocabulary names id index+1 and their class");
+
+        volatile int sink = 0;
+        const auto index = nsPerCall(opt.iters, [&](int i) {
+            sink = sink + EventClassifier::vocabularyIndex(vocabName(i));
+        });
+        const auto scan = nsPerCall(opt.iters, [&](int i) {
+            sink = sink + refIndex(vocabName(i));
+        });
+        std::printf("  vocabulary lookup: vocabularyIndex %.1f ns, reference scan %.1f ns\n", index, scan);
+    }
+
+    void checkIntern(const Options& opt) {
+        std::vector<std::string> names;
+        for (int i = 0; i < opt.names; ++i) names.push_back("RmfCheck_Callback" + std::to_string(i * 7919));
+
+        // Every thread resolves every name, each starting at a different offset so inserts race
+        std::vector<std::vector<EventNames::EventId>> ids(static_cast<std::size_t>(opt.threads));
+        std::atomic<int> ready{0};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < opt.threads; ++t) {
+            threads.emplace_back([&, t] {
+                auto& out = ids[static_cast<std::size_t>(t)];
+                out.resize(names.size());
+                ready.fetch_add(1);
+                while (ready.load() < opt.threads) {
+                }
+                for (std::size_t k = 0; k < names.size(); ++k) {
+                    const auto i = (k + static_cast<std::size_t>(t) * 13) % names.size();
+                    out[i] = EventNames::intern(names[i]);
+                }
+            });
+        }
+        for (auto& th : threads) th.join();
+
+        std::unordered_map<EventNames::EventId, std::string> byId;  // reference: id -> the one name
+        bool agree = true, distinct = true, roundTrip = true;
+        for (std::size_t i = 0; i < names.size(); ++i) {
+            const auto id = ids[0][i];
+            for (const auto& other : ids) agree = agree && other[i] == id;
+            distinct = distinct && id != EventNames::NO_EVENT && byId.emplace(id, names[i]).second;
+            roundTrip = roundTrip && EventNames::nameOf(id) == names[i] &&
+                        EventNames::classOf(id) == EventNames::resolve(names[i]).cls;
+        }
+        std::printf("intern: %d thread(s) x %zu runtime name(s), %zu distinct id(s)\n", opt.threads, names.size(),
+                    byId.size());
+        check(agree, "all threads got the same id for each name");
+        check(distinct, "different names got different, non-zero ids");
+        check(roundTrip, "nameOf / classOf round-trip");
+        check(EventNames::intern("") == EventNames::NO_EVENT, "empty name is NO_EVENT");
+
+        std::unordered_map<std::string, EventNames::EventId> ref;
+        for (std::size_t i = 0; i < names.size(); ++i) ref.emplace(names[i], ids[0][i]);
+
+        volatile std::uint32_t sink = 0;
+        const auto known = nsPerCall(opt.iters, [&](int i) {
+            sink = sink + EventNames::intern(i & 1 ? "ChangeHeadPart" : "ChangeWeight");
+        });
+        const auto runtime = nsPerCall(opt.iters, [&](int i) {
+            sink = sink + EventNames::intern(names[static_cast<std::size_t>(i) % names.size()]);
+        });
+        const auto map = nsPerCall(opt.iters, [&](int i) {
+            sink = sink + ref.find(names[static_cast<std::size_t>(i) % names.size()])->second;
+        });
+        std::printf("  resolve: vocabulary %.1f ns, runtime name %.1f ns (std::unordered_map lookup %.1f ns)\n", known,
+                    runtime, map);
+    }
+
+    bool parseArgs(int argc, char** argv, Options& opt) {
+        for (int i = 1; i + 1 < argc; i += 2) {
+            const std::string_view a = argv[i];
+            const int v = std::atoi(argv[i + 1]);
+            if (a == "--threads") {
+                opt.threads = v;
+            } else if (a == "--names") {
+                opt.names = v;
+            } else if (a == "--iters") {
+                opt.iters = v;
+            } else if (a == "--cases") {
+                opt.cases = v;
+            } else {
+                return false;
+            }
+        }
+        return argc % 2 == 1 && opt.threads > 0 && opt.names > 0 && opt.names <= 200 && opt.iters > 0 && opt.cases >= 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        std::fprintf(stderr, "usage: %s [--threads N] [--names N (max 200)] [--iters N] [--cases N]\n",
+                     argv[0]);
+        return 2;
+    }
+
+    checkClassify(opt);
+    checkIntern(opt);
+
+    if (g_failed) std::printf("%d check(s) failed\n", g_failed);
+    return g_failed ? 1 : 0;
+}
@@ -0,0 +1,177 @@
+// float_diff_check: checks FloatDiff::any / changed (the SIMD dispatch) against anyScalar /
+// changedScalar and times both at morph-snapshot sizes.
+//
+//   check  - random value arrays of every length up to --max-len, with a few elements moved by
+//            about the tolerance (just inside and just outside), NaN, infinities and -0; both
+//            sides of each pair must agree, also for spans of different lengths
+//   bench  - ns per call for an unchanged snapshot (any() scans everything) and one with a single
+//            late change, at a few sizes around a 120-morph x 3-key preset
+//
+// Exits 1 on any mismatch.
+//
+// usage: float_diff_check [--cases N] [--max-len N] [--iters N]
+//   --cases <n>    random array pairs per length (default 200)
+//   --max-len <n>  longest random array (default 300)
+//   --iters <n>    calls per timing (default 200000)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "helpers/cpu_features.h"
+#include "helpers/float_diff.h"
+
+namespace {
+    namespace FloatDiff = MorphFixer::Helpers::FloatDiff;
+    using Clock = std::chrono::steady_clock;
+
+    constexpr float TOLERANCE = 1e-5f;  // as MorphUpdater::MenuDriver
+
+    struct Options {
+        int cases{200};
+        int max_len{300};
+        int iters{200000};
+    };
+
+    template <class Fn>
+    double nsPerCall(int iters, Fn&& fn) {
+        const auto t0 = Clock::now();
+        for (int i = 0; i < iters; ++i) fn(i);
+        return std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / iters;
+    }
+
+    unsigned next(unsigned& r) {
+        r = r * 1664525u + 1013904223u;
+        return r >> 8;
+    }
+
+    // b is a copy of a with a few elements disturbed: by ~tolerance either way, or to a special value
+    void makePair(std::size_t len, unsigned& r, std::vector<float>& a, std::vector<float>& b) {
+        a.resize(len);
+        for (auto& v : a) v = static_cast<float>(next(r) % 2001) / 1000.0f - 1.0f;
+        b = a;
+        const auto edits = len ? next(r) % 4 : 0;
+        for (unsigned e = 0; e < edits; ++e) {
+            const auto i = next(r) % len;
+            switch (next(r) % 6) {
+                case 0:
+                    b[i] += TOLERANCE * 0.5f;
+                    break;
+                case 1:
+                    b[i] += TOLERANCE * 4.0f;
+                    break;
+                case 2:
+                    b[i] = std::numeric_limits<float>::quiet_NaN();
+                    break;
+                case 3:
+                    (next(r) & 1 ? a : b)[i] = std::numeric_limits<float>::infinity();
+                    break;
+                case 4:
+                    a[i] = 0.0f;
+                    b[i] = -0.0f;
+                    break;
+                default:
+                    b[i] = -b[i];
+                    break;
+            }
+        }
+    }
+
+    std::size_t checkRandom(const Options& opt) {
+        std::size_t pairs = 0, changedPairs = 0, mismatches = 0;
+        std::vector<float> a, b;
+        std::vector<std::uint32_t> fast, ref;
+        unsigned r = 0xF10Au;
+        for (int len = 0; len <= opt.max_len; ++len) {
+            for (int c = 0; c < opt.cases; ++c) {
+                makePair(static_cast<std::size_t>(len), r, a, b);
+                // Now and then compare against a shorter b: only the common prefix counts
+                const auto bLen = (next(r) % 8 == 0 && len) ? next(r) % static_cast<unsigned>(len) : b.size();
+                const std::span<const float> sa{a}, sb{b.data(), bLen};
+
+                fast.assign(1, 0xFFFFFFFFu);  // changed() appends: keep a sentinel in front
+                ref.assign(1, 0xFFFFFFFFu);
+                const auto nFast = FloatDiff::changed(sa, sb, TOLERANCE, fast);
+                const auto nRef = FloatDiff::changedScalar(sa, sb, TOLERANCE, ref);
+                const bool anyFast = FloatDiff::any(sa, sb, TOLERANCE);
+                const bool anyRef = FloatDiff::anyScalar(sa, sb, TOLERANCE);
+
+                ++pairs;
+                if (anyRef) ++changedPairs;
+                if (anyFast != anyRef || nFast != nRef || fast != ref || anyRef != (nRef > 0)) {
+                    if (mismatches++ < 5) {
+                        std::printf("  MISMATCH len=%d/%zu any=%d/%d changed=%zu/%zu\n", len, bLen, anyFast, anyRef,
+                                    nFast, nRef);
+                    }
+                }
+            }
+        }
+        std::printf("check: %zu pair(s), %zu with changes, %zu mismatch(es), avx2=%s\n", pairs, changedPairs,
+                    mismatches, MorphFixer::Helpers::Cpu::hasAvx2() ? "yes" : "no");
+        return mismatches;
+    }
+
+    void bench(const Options& opt) {
+        std::printf("bench: tolerance %g\n", static_cast<double>(TOLERANCE));
+        unsigned r = 0xB3u;
+        std::vector<float> a, b;
+        std::vector<std::uint32_t> out;
+        for (const std::size_t len : {96u, 360u, 1024u, 4096u}) {
+            makePair(len, r, a, b);
+            b = a;
+            const int iters = std::max(1, static_cast<int>(opt.iters * 360 / len));
+            volatile std::size_t sink = 0;
+            const auto anyFast = nsPerCall(iters, [&](int) { sink = sink + FloatDiff::any(a, b, TOLERANCE); });
+            const auto anyRef = nsPerCall(iters, [&](int) { sink = sink + FloatDiff::anyScalar(a, b, TOLERANCE); });
+
+            b[len - 3] += 1.0f;
+            const auto chFast = nsPerCall(iters, [&](int) {
+                out.clear();
+                sink = sink + FloatDiff::changed(a, b, TOLERANCE, out);
+            });
+            const auto chRef = nsPerCall(iters, [&](int) {
+                out.clear();
+                sink = sink + FloatDiff::changedScalar(a, b, TOLERANCE, out);
+            });
+            std::printf("  %4zu floats: any %.1f ns (scalar %.1f), changed %.1f ns (scalar %.1f)\n", len, anyFast,
+                        anyRef, chFast, chRef);
+        }
+    }
+
+    bool parseArgs(int argc, char** argv, Options& opt) {
+        for (int i = 1; i + 1 < argc; i += 2) {
+            const std::string_view a = argv[i];
+            const int v = std::atoi(argv[i + 1]);
+            if (a == "--cases") {
+                opt.cases = v;
+            } else if (a == "--max-len") {
+                opt.max_len = v;
+            } else if (a == "--iters") {
+                opt.iters = v;
+            } else {
+                return false;
+            }
+        }
+        return argc % 2 == 1 && opt.cases > 0 && opt.max_len >= 0 && opt.iters > 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        std::fprintf(stderr, "usage: %s [--cases N] [--max-len N] [--iters N]\n", argv[0]);
+        return 2;
+    }
+
+    const auto mismatches = checkRandom(opt);
+    bench(opt);
+
+    if (mismatches) std::printf("FAILED: SIMD and scalar results differ\n");
+    return mismatches ? 1 : 0;
+}
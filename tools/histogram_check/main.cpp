@@ -0,0 +1,173 @@
+// histogram_check: checks LogLinearHistogram percentiles against exact ones from the sorted
+// samples, and its counts under concurrent record().
+//
+//   exact   - several distributions (refresh-like ns latencies, uniform, bimodal, powers of two,
+//             values near 2^64); for each quantile the reported value must lie in
+//             [exact, exact + exact / SUB_BUCKETS] and never above the recorded max
+//   threads - --threads writers recording at once; count, max and the p50/p99 must match the
+//             same samples recorded from one thread
+//
+// Exits 1 on any mismatch.
+//
+// usage: histogram_check [--samples N] [--threads N]
+//   --samples <n>  samples per distribution (default 200000)
+//   --threads <n>  concurrent writers (default 4)
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "helpers/histogram.h"
+
+namespace {
+    using MorphFixer::Helpers::LogLinearHistogram;
+    using Clock = std::chrono::steady_clock;
+
+    constexpr double QUANTILES[] = {0.0, 0.01, 0.25, 0.5, 0.9, 0.99, 0.999, 1.0};
+
+    struct Options {
+        int samples{200000};
+        int threads{4};
+    };
+
+    int g_failed = 0;
+
+    void check(bool ok, const char* what) {
+        if (ok) return;
+        std::printf("  CHECK FAILED: %s\n", what);
+        ++g_failed;
+    }
+
+    std::uint64_t next(std::uint64_t& r) {
+        r = r * 6364136223846793005ull + 1442695040888963407ull;
+        return r >> 11;
+    }
+
+    double unit(std::uint64_t& r) { return static_cast<double>(next(r)) / 9007199254740992.0; }
+
+    enum class Shape { kRefresh, kUniform, kBimodal, kPowers, kHuge };
+    constexpr const char* SHAPE_NAMES[] = {"refresh", "uniform", "bimodal", "powers", "huge"};
+
+    std::vector<std::uint64_t> makeSamples(Shape shape, int n, std::uint64_t seed) {
+        std::vector<std::uint64_t> out(static_cast<std::size_t>(n));
+        for (auto& v : out) {
+            switch (shape) {
+                case Shape::kRefresh:  // log-normal around 2 ms with a long tail
+                    v = static_cast<std::uint64_t>(2e6 * std::exp(0.8 * std::sqrt(-2.0 * std::log(unit(seed) + 1e-12)) *
+                                                                  std::cos(6.283185307179586 * unit(seed))));
+                    break;
+                case Shape::kUniform:
+                    v = next(seed) % 100000;
+                    break;
+                case Shape::kBimodal:
+                    v = next(seed) % 10 ? 40000 + next(seed) % 5000 : 150000000 + next(seed) % 1000000;
+                    break;
+                case Shape::kPowers:
+                    v = 1ull << (next(seed) % 63);
+                    break;
+                case Shape::kHuge:
+                    v = ~0ull - next(seed) % 1000000000000ull;
+                    break;
+            }
+        }
+        return out;
+    }
+
+    std::uint64_t exactPercentile(const std::vector<std::uint64_t>& sorted, double q) {
+        // Same rank rule as LogLinearHistogram::percentile: the ceil(q * n)-th smallest, at least the first
+        const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(q * sorted.size())));
+        return sorted[rank - 1];
+    }
+
+    void checkExact(const Options& opt) {
+        auto hist = std::make_unique<LogLinearHistogram>();
+        for (int s = 0; s < static_cast<int>(std::size(SHAPE_NAMES)); ++s) {
+            auto samples = makeSamples(static_cast<Shape>(s), opt.samples, 0xA11CEull + static_cast<std::uint64_t>(s));
+            hist->reset();
+            for (const auto v : samples) hist->record(v);
+            std::sort(samples.begin(), samples.end());
+
+            double worst = 0.0;
+            bool ok = hist->count() == samples.size() && hist->max() == samples.back();
+            for (const auto q : QUANTILES) {
+                const auto exact = exactPercentile(samples, q);
+                const auto got = hist->percentile(q);
+                ok = ok && got >= exact && got - exact <= exact / LogLinearHistogram::SUB_BUCKETS &&
+                     got <= hist->max();
+                if (exact) worst = std::max(worst, static_cast<double>(got - exact) / static_cast<double>(exact));
+            }
+            const auto sum = hist->summary();
+            std::printf("exact %-8s p50=%llu (exact %llu) p99=%llu (exact %llu) worst_error=%.2f%%\n",
+                        SHAPE_NAMES[s], static_cast<unsigned long long>(sum.p50),
+                        static_cast<unsigned long long>(exactPercentile(samples, 0.5)),
+                        static_cast<unsigned long long>(sum.p99),
+                        static_cast<unsigned long long>(exactPercentile(samples, 0.99)), worst * 100.0);
+            check(ok, "percentiles within one sub-bucket above the exact value, count and max exact");
+        }
+
+        hist->reset();
+        check(hist->percentile(0.5) == 0 && hist->summary().count == 0, "empty histogram reports zeros");
+        hist->recordSigned(-5);
+        check(hist->count() == 1 && hist->max() == 0, "negative samples clamp to 0");
+    }
+
+    void checkThreads(const Options& opt) {
+        const auto samples = makeSamples(Shape::kRefresh, opt.samples, 0x7EADull);
+        auto single = std::make_unique<LogLinearHistogram>();
+        auto shared = std::make_unique<LogLinearHistogram>();
+        for (const auto v : samples) single->record(v);
+
+        const auto t0 = Clock::now();
+        std::vector<std::thread> writers;
+        for (int t = 0; t < opt.threads; ++t) {
+            writers.emplace_back([&, t] {
+                for (std::size_t i = static_cast<std::size_t>(t); i < samples.size(); i += opt.threads) {
+                    shared->record(samples[i]);
+                }
+            });
+        }
+        for (auto& w : writers) w.join();
+        const auto ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / samples.size();
+
+        const auto a = single->summary(), b = shared->summary();
+        std::printf("threads: %d writer(s), %zu sample(s), %.1f ns per record\n", opt.threads, samples.size(), ns);
+        check(a.count == b.count && a.max == b.max && a.p50 == b.p50 && a.p99 == b.p99,
+              "concurrent record() matches single-threaded record()");
+    }
+
+    bool parseArgs(int argc, char** argv, Options& opt) {
+        for (int i = 1; i + 1 < argc; i += 2) {
+            const std::string_view a = argv[i];
+            const int v = std::atoi(argv[i + 1]);
+            if (a == "--samples") {
+                opt.samples = v;
+            } else if (a == "--threads") {
+                opt.threads = v;
+            } else {
+                return false;
+            }
+        }
+        return argc % 2 == 1 && opt.samples > 0 && opt.threads > 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        std::fprintf(stderr, "usage: %s [--samples N] [--threads N]\n", argv[0]);
+        return 2;
+    }
+
+    checkExact(opt);
+    checkThreads(opt);
+
+    if (g_failed) std::printf("%d check(s) failed\n", g_failed);
+    return g_failed ? 1 : 0;
+}
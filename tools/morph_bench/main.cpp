@@ -0,0 +1,273 @@
+// morph_bench: runs the morph features against the in-memory SKEE (tools/skee_mock) and reports
+// SKEE call counts and wall time. No game needed; exits non-zero when a check fails.
+//
+//   batch     - a preset-sized set of SetMorph ops pushed through MorphBatch vs one call at a time
+//               (SetMorph + ApplyBodyMorphs + UpdateModelWeight per op); final values must match
+//   snapshot  - the skip-unchanged check: VisitMorphValues into a MorphSnapshot, then sameAs /
+//               changedRows against the previous one, with and without a changed value
+//   faults    - the batch again with failure injection on SetMorph; every call is still accounted for
+//
+// usage: morph_bench [options]
+//   --actors <n>      actors per batch (default 4)
+//   --morphs <n>      morph names per actor (default 120)
+//   --keys <n>        keys per morph name (default 3)
+//   --iters <n>       repetitions per measurement (default 50)
+//   --apply-us <us>   latency of ApplyBodyMorphs (default 200)
+//   --update-us <us>  latency of UpdateModelWeight (default 500)
+//   --fail-rate <p>   SetMorph failure rate for the faults run (default 0.05)
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "features/morph_batch.h"
+#include "features/morph_snapshot.h"
+#include "skee_mock/skee_mock.h"
+
+namespace {
+    using MorphFixer::MorphBatch;
+    using MorphFixer::MorphSnapshot;
+    using MorphFixer::MorphStringIds;
+    using MorphFixer::Tools::SkeeMock;
+    using Method = SkeeMock::Method;
+    using Clock = std::chrono::steady_clock;
+
+    constexpr float MORPH_TOLERANCE = 1e-5f;  // as MorphUpdater::MenuDriver
+
+    struct Options {
+        int actors{4};
+        int morphs{120};
+        int keys{3};
+        int iters{50};
+        double apply_us{200.0};
+        double update_us{500.0};
+        double fail_rate{0.05};
+    };
+
+    struct Op {
+        std::uint32_t formId;
+        std::string name;
+        std::string key;
+        float value;
+    };
+
+    int g_failed = 0;
+
+    void check(bool ok, const char* what) {
+        if (ok) return;
+        std::printf("  CHECK FAILED: %s\n", what);
+        ++g_failed;
+    }
+
+    double msSince(Clock::time_point t0) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+
+    std::chrono::nanoseconds us(double v) { return std::chrono::nanoseconds(static_cast<long long>(v * 1000.0)); }
+
+    // One preset's worth of ops: every (actor, name, key), with a second write to each tenth key
+    // so the batch has something to supersede.
+    std::vector<Op> makeOps(const Options& opt, int round) {
+        std::vector<Op> ops;
+        for (int a = 0; a < opt.actors; ++a) {
+            for (int n = 0; n < opt.morphs; ++n) {
+                for (int k = 0; k < opt.keys; ++k) {
+                    const auto v = static_cast<float>((a * 31 + n * 7 + k + round) % 100) / 100.0f;
+                    ops.push_back({0x14u + static_cast<std::uint32_t>(a), "Morph" + std::to_string(n),
+                                   "RaceMenuMorphsCBBE" + std::to_string(k), v});
+                    if ((n + k) % 10 == 0) ops.push_back({ops.back().formId, ops.back().name, ops.back().key, v + 1.0f});
+                }
+            }
+        }
+        return ops;
+    }
+
+    void configure(SkeeMock& skee, const Options& opt) {
+        skee.setFault(Method::kApplyBodyMorphs, {us(opt.apply_us)});
+        skee.setFault(Method::kUpdateModelWeight, {us(opt.update_us)});
+    }
+
+    void printCalls(const SkeeMock& skee, std::initializer_list<Method> methods) {
+        for (const auto m : methods) {
+            std::printf("    %-18.*s calls=%llu failures=%llu\n", static_cast<int>(SkeeMock::methodName(m).size()),
+                        SkeeMock::methodName(m).data(), static_cast<unsigned long long>(skee.calls(m)),
+                        static_cast<unsigned long long>(skee.failures(m)));
+        }
+    }
+
+    bool sameValues(SkeeMock& a, SkeeMock& b, const std::vector<Op>& ops) {
+        for (const auto& op : ops) {
+            const auto va = a.GetMorph(a.actor(op.formId), op.name.c_str(), op.key.c_str());
+            const auto vb = b.GetMorph(b.actor(op.formId), op.name.c_str(), op.key.c_str());
+            if (va != vb) return false;
+        }
+        return true;
+    }
+
+    void benchBatch(const Options& opt) {
+        const auto ops = makeOps(opt, 0);
+        std::printf("batch: %d actor(s) x %d morph(s) x %d key(s), %zu ops\n", opt.actors, opt.morphs, opt.keys,
+                    ops.size());
+
+        SkeeMock single, batched;
+        configure(single, opt);
+        configure(batched, opt);
+
+        const auto t0 = Clock::now();
+        for (const auto& op : ops) {
+            auto* actor = single.actor(op.formId);
+            single.SetMorph(actor, op.name.c_str(), op.key.c_str(), op.value);
+            single.ApplyBodyMorphs(actor, true);
+            single.UpdateModelWeight(actor, true);
+        }
+        const auto singleMs = msSince(t0);
+
+        MorphBatch batch;
+        MorphBatch::Result r;
+        double batchMs = 0.0;
+        for (int i = 0; i < opt.iters; ++i) {
+            for (const auto& op : ops) batch.set(batched.actor(op.formId), op.name, op.key, op.value);
+            const auto t1 = Clock::now();
+            r = batch.apply(batched);
+            batchMs += msSince(t1);
+        }
+        batchMs /= opt.iters;
+
+        std::printf("  one call at a time: %.3f ms, %llu SKEE calls\n", singleMs,
+                    static_cast<unsigned long long>(single.totalCalls()));
+        std::printf("  MorphBatch:         %.3f ms/apply, %llu SKEE calls/apply (sets=%u superseded=%u actors=%u)\n",
+                    batchMs, static_cast<unsigned long long>(batched.totalCalls() / opt.iters), r.sets, r.superseded,
+                    r.actors);
+
+        check(sameValues(single, batched, ops), "batched values differ from one-at-a-time values");
+        check(r.actors == static_cast<std::uint32_t>(opt.actors), "one apply per actor");
+        check(r.sets + r.superseded == ops.size(), "every op either set or superseded");
+        check(batched.calls(Method::kApplyBodyMorphs) == static_cast<std::uint64_t>(opt.actors) * opt.iters,
+              "ApplyBodyMorphs once per actor per apply");
+    }
+
+    struct SnapshotVisitor final : SKEE::IBodyMorphInterface::MorphValueVisitor {
+        SnapshotVisitor(MorphStringIds& ids, MorphSnapshot& out) : m_ids(ids), m_out(out) {}
+
+        void Visit(RE::TESObjectREFR*, const char* name, const char* key, float value) override {
+            if (!name || !key) return;
+            m_out.add(m_ids.intern(name), m_ids.intern(key), value);
+        }
+
+        MorphStringIds& m_ids;
+        MorphSnapshot& m_out;
+    };
+
+    void take(SkeeMock& skee, RE::TESObjectREFR* player, MorphStringIds& ids, MorphSnapshot& out) {
+        out.clear();
+        SnapshotVisitor visitor{ids, out};
+        skee.VisitMorphValues(player, visitor);
+        out.finish();
+    }
+
+    void benchSnapshot(const Options& opt) {
+        SkeeMock skee;
+        auto* player = skee.actor(0x14);
+        for (const auto& op : makeOps(opt, 0)) {
+            if (op.formId == 0x14) skee.SetMorph(player, op.name.c_str(), op.key.c_str(), op.value);
+        }
+        const auto rows = skee.morphCount(player);
+        std::printf("snapshot: %zu morph value(s) on the player\n", rows);
+
+        MorphStringIds ids;
+        MorphSnapshot applied, current;
+        take(skee, player, ids, applied);
+
+        const auto t0 = Clock::now();
+        bool same = true;
+        for (int i = 0; i < opt.iters; ++i) {
+            take(skee, player, ids, current);
+            same = same && current.sameAs(applied, MORPH_TOLERANCE);
+        }
+        const auto unchangedUs = msSince(t0) * 1000.0 / opt.iters;
+
+        skee.SetMorph(player, "Morph0", "RaceMenuMorphsCBBE1", 0.75f);
+        std::vector<std::uint32_t> changed;
+        take(skee, player, ids, current);
+        const bool sameAfter = current.sameAs(applied, MORPH_TOLERANCE);
+        if (current.sameRows(applied)) current.changedRows(applied, MORPH_TOLERANCE, changed);
+
+        std::printf("  snapshot + compare: %.2f us (%d iters), strings interned=%zu\n", unchangedUs, opt.iters,
+                    ids.size());
+        std::printf("  after one SetMorph: changed rows=%zu\n", changed.size());
+
+        check(current.size() == rows && applied.size() == rows, "snapshot holds every morph value");
+        check(same, "unchanged morphs compare equal");
+        check(!sameAfter && changed.size() == 1, "one changed value is detected");
+    }
+
+    void benchFaults(const Options& opt) {
+        const auto ops = makeOps(opt, 1);
+        std::printf("faults: SetMorph fail_rate=%.3f, ApplyBodyMorphs fails every 3rd call\n", opt.fail_rate);
+
+        SkeeMock skee(42);
+        skee.setFault(Method::kSetMorph, {std::chrono::nanoseconds(0), 0, opt.fail_rate});
+        skee.setFault(Method::kApplyBodyMorphs, {std::chrono::nanoseconds(0), 3, 0.0});
+
+        MorphBatch batch;
+        for (const auto& op : ops) batch.set(skee.actor(op.formId), op.name, op.key, op.value);
+        const auto r = batch.apply(skee);
+
+        std::size_t stored = 0;
+        for (int a = 0; a < opt.actors; ++a) stored += skee.morphCount(skee.actor(0x14u + static_cast<std::uint32_t>(a)));
+        printCalls(skee, {Method::kSetMorph, Method::kApplyBodyMorphs, Method::kUpdateModelWeight});
+        std::printf("  values stored=%zu of %u sets\n", stored, r.sets);
+
+        check(skee.calls(Method::kSetMorph) == r.sets, "one SetMorph call per set");
+        check(stored + skee.failures(Method::kSetMorph) == r.sets, "failed SetMorph calls store nothing");
+        check(skee.failures(Method::kApplyBodyMorphs) == static_cast<std::uint64_t>(opt.actors / 3),
+              "every 3rd ApplyBodyMorphs fails");
+    }
+
+    bool parseArgs(int argc, char** argv, Options& opt) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view a = argv[i];
+            if (i + 1 >= argc) return false;
+            const double v = std::atof(argv[++i]);
+            if (a == "--actors") {
+                opt.actors = static_cast<int>(v);
+            } else if (a == "--morphs") {
+                opt.morphs = static_cast<int>(v);
+            } else if (a == "--keys") {
+                opt.keys = static_cast<int>(v);
+            } else if (a == "--iters") {
+                opt.iters = static_cast<int>(v);
+            } else if (a == "--apply-us") {
+                opt.apply_us = v;
+            } else if (a == "--update-us") {
+                opt.update_us = v;
+            } else if (a == "--fail-rate") {
+                opt.fail_rate = v;
+            } else {
+                return false;
+            }
+        }
+        return opt.actors > 0 && opt.morphs > 0 && opt.keys > 0 && opt.iters > 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        std::fprintf(stderr,
+                     "usage: %s [--actors N] [--morphs N] [--keys N] [--iters N] [--apply-us N] [--update-us N] "
+                     "[--fail-rate P]\n",
+                     argv[0]);
+        return 2;
+    }
+
+    benchBatch(opt);
+    benchSnapshot(opt);
+    benchFaults(opt);
+
+    if (g_failed) std::printf("%d check(s) failed\n", g_failed);
+    return g_failed ? 1 : 0;
+}
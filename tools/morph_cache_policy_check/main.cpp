@@ -0,0 +1,212 @@
+// morph_cache_policy_check: checks MorphCachePolicy (SKEE morph cache sizing) against the rule it
+// documents, on the shipped config and on random ones, including inverted and negative bounds.
+//
+//   configure - bounds are clamped: min >= 0, max >= min, low >= 0, high > low, poll >= 1000 ms
+//   pressure  - low below low water, elevated between the marks, high at or above high water
+//   limit     - full budget up to low water, the minimum from high water, linear in between; always
+//               within [min, max], a whole LIMIT_STEP_BYTES multiple (or the minimum), and never
+//               growing as the reading grows
+//   clear     - only when enabled and at or above low water
+//
+// Then prints the limit at a few readings for the shipped water marks. Exits 1 on any mismatch.
+//
+// usage: morph_cache_policy_check [--configs N] [--readings N]
+//   --configs <n>   random configs (default 2000)
+//   --readings <n>  random readings per config, on top of the edges (default 500)
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include <vector>
+
+#include "features/morph_cache_policy.h"
+
+namespace {
+    using MorphFixer::MorphCachePolicy;
+    using Pressure = MorphCachePolicy::Pressure;
+
+    constexpr std::uint64_t MB = 1ull << 20;
+    constexpr std::uint64_t STEP = MorphCachePolicy::LIMIT_STEP_BYTES;
+
+    struct Options {
+        int configs{2000};
+        int readings{500};
+    };
+
+    int g_failed = 0;
+
+    void check(bool ok, const char* what, const MorphCachePolicy::Config& c, std::uint64_t reading) {
+        if (ok) return;
+        if (++g_failed <= 20) {
+            std::printf("  CHECK FAILED: %s (limit %d..%d MB, water %d/%d MB, reading %.3f MB)\n", what,
+                        c.limit_min_mb, c.limit_max_mb, c.low_water_mb, c.high_water_mb,
+                        static_cast<double>(reading) / static_cast<double>(MB));
+        }
+    }
+
+    std::uint64_t next(std::uint64_t& r) {
+        r = r * 6364136223846793005ull + 1442695040888963407ull;
+        return r >> 11;
+    }
+
+    int pickMb(std::uint64_t& r, int lo, int hi) {
+        return lo + static_cast<int>(next(r) % static_cast<std::uint64_t>(hi - lo + 1));
+    }
+
+    // The shipped INI values, with management switched on
+    MorphCachePolicy::Config shipped() {
+        MorphCachePolicy::Config c;
+        c.enabled = true;
+        return c;
+    }
+
+    MorphCachePolicy::Config randomConfig(std::uint64_t& r) {
+        MorphCachePolicy::Config c;
+        c.enabled = next(r) % 4 != 0;
+        c.limit_min_mb = pickMb(r, -64, 2048);
+        c.limit_max_mb = pickMb(r, -64, 4096);
+        c.low_water_mb = pickMb(r, -64, 16384);
+        c.high_water_mb = pickMb(r, -64, 24576);
+        c.poll_ms = pickMb(r, -10, 30000);
+        return c;
+    }
+
+    // Clamped bounds, written out from the rule rather than taken from the policy
+    struct Bounds {
+        std::uint64_t minLimit, maxLimit, lo, hi;
+    };
+
+    Bounds boundsFor(const MorphCachePolicy::Config& c) {
+        const std::uint64_t minMb = static_cast<std::uint64_t>(std::max(0, c.limit_min_mb));
+        const std::uint64_t maxMb = std::max(minMb, static_cast<std::uint64_t>(std::max(0, c.limit_max_mb)));
+        const std::uint64_t loMb = static_cast<std::uint64_t>(std::max(0, c.low_water_mb));
+        const std::uint64_t hiMb = std::max(loMb + 1, static_cast<std::uint64_t>(std::max(0, c.high_water_mb)));
+        return {minMb * MB, maxMb * MB, loMb * MB, hiMb * MB};
+    }
+
+    Pressure refPressure(const Bounds& b, std::uint64_t reading) {
+        if (reading >= b.hi) return Pressure::kHigh;
+        if (reading >= b.lo) return Pressure::kElevated;
+        return Pressure::kLow;
+    }
+
+    // Unrounded linear limit, in exact integer arithmetic. Every bound is whole MB, so dividing
+    // both spans by MB keeps the product well inside 64 bits.
+    std::uint64_t refLimit(const Bounds& b, std::uint64_t reading) {
+        if (reading <= b.lo) return b.maxLimit;
+        if (reading >= b.hi) return b.minLimit;
+        const auto drop = (b.maxLimit - b.minLimit) / MB * (reading - b.lo) / ((b.hi - b.lo) / MB);
+        return b.maxLimit - drop;
+    }
+
+    std::uint64_t roundLimit(const Bounds& b, std::uint64_t limit) {
+        return std::max(b.minLimit, limit / STEP * STEP);
+    }
+
+    std::vector<std::uint64_t> readingsFor(const Bounds& b, int count, std::uint64_t& r) {
+        std::vector<std::uint64_t> out = {0, 1, b.hi, b.hi + 1, 64ull << 30, ~0ull};
+        for (const auto mark : {b.lo, b.hi}) {
+            if (mark) out.push_back(mark - 1);
+        }
+        out.push_back(b.lo);
+        out.push_back(b.lo + 1);
+        out.push_back(b.lo + (b.hi - b.lo) / 2);
+        const auto top = b.hi + b.hi / 4 + 1;
+        for (int i = 0; i < count; ++i) out.push_back(next(r) % top);
+        std::sort(out.begin(), out.end());
+        return out;
+    }
+
+    void checkConfig(const MorphCachePolicy::Config& cfg, int readings, std::uint64_t& r) {
+        MorphCachePolicy policy;
+        policy.configure(cfg);
+        const auto& c = policy.config();
+        const auto b = boundsFor(cfg);
+
+        check(c.enabled == cfg.enabled, "enabled changed by configure", cfg, 0);
+        check(c.limit_min_mb >= 0 && c.limit_max_mb >= c.limit_min_mb, "limit bounds not clamped", cfg, 0);
+        check(c.low_water_mb >= 0 && c.high_water_mb > c.low_water_mb, "water marks not clamped", cfg, 0);
+        check(c.poll_ms >= 1000 && (cfg.poll_ms < 1000 || c.poll_ms == cfg.poll_ms), "poll not clamped", cfg, 0);
+        check(static_cast<std::uint64_t>(c.limit_min_mb) * MB == b.minLimit &&
+                  static_cast<std::uint64_t>(c.limit_max_mb) * MB == b.maxLimit &&
+                  static_cast<std::uint64_t>(c.low_water_mb) * MB == b.lo &&
+                  static_cast<std::uint64_t>(c.high_water_mb) * MB == b.hi,
+              "clamped bounds differ from the rule", cfg, 0);
+
+        std::uint64_t prev = ~0ull;
+        for (const auto reading : readingsFor(b, readings, r)) {
+            const auto pressure = policy.pressureFor(reading);
+            check(pressure == refPressure(b, reading), "pressure", cfg, reading);
+            const bool clear = cfg.enabled && pressure != Pressure::kLow;
+            check(policy.clearAtSafePoint(reading) == clear, "clear at safe point", cfg, reading);
+
+            const auto limit = policy.limitFor(reading);
+            check(limit >= b.minLimit && limit <= b.maxLimit, "limit outside [min, max]", cfg, reading);
+            check(limit % STEP == 0 || limit == b.minLimit, "limit not on a step", cfg, reading);
+            check(limit <= prev, "limit grew with the reading", cfg, reading);
+            prev = limit;
+
+            // The policy interpolates in double, so between the marks it may round to the step
+            // next to the exact one
+            const auto want = roundLimit(b, refLimit(b, reading));
+            const auto diff = limit > want ? limit - want : want - limit;
+            check(diff == 0 || (diff == STEP && reading > b.lo && reading < b.hi), "limit off the line", cfg,
+                  reading);
+            if (reading <= b.lo) check(limit == roundLimit(b, b.maxLimit), "limit below low water", cfg, reading);
+            if (reading >= b.hi) check(limit == b.minLimit, "limit at high water", cfg, reading);
+        }
+    }
+
+    void printShipped() {
+        MorphCachePolicy policy;
+        policy.configure(shipped());
+        const auto& c = policy.config();
+        std::printf("shipped config: limit %d..%d MB, water %d/%d MB\n", c.limit_min_mb, c.limit_max_mb,
+                    c.low_water_mb, c.high_water_mb);
+        for (const int mb : {2048, 6144, 7168, 8192, 9216, 10240, 12288}) {
+            const auto reading = static_cast<std::uint64_t>(mb) * MB;
+            const char* pressure = "low";
+            if (policy.pressureFor(reading) == Pressure::kElevated) pressure = "elevated";
+            if (policy.pressureFor(reading) == Pressure::kHigh) pressure = "high";
+            std::printf("  process %6d MB  %-8s  limit %5llu MB  clear=%s\n", mb, pressure,
+                        static_cast<unsigned long long>(policy.limitFor(reading) / MB),
+                        policy.clearAtSafePoint(reading) ? "yes" : "no");
+        }
+    }
+
+    bool parseArgs(int argc, char** argv, Options& opt) {
+        for (int i = 1; i + 1 < argc; i += 2) {
+            const std::string_view a = argv[i];
+            const int v = std::atoi(argv[i + 1]);
+            if (a == "--configs") {
+                opt.configs = v;
+            } else if (a == "--readings") {
+                opt.readings = v;
+            } else {
+                return false;
+            }
+        }
+        return argc % 2 == 1 && opt.configs >= 0 && opt.readings >= 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        std::fprintf(stderr, "usage: %s [--configs N] [--readings N]\n", argv[0]);
+        return 2;
+    }
+
+    std::uint64_t r = 0x5EED;
+    checkConfig(shipped(), opt.readings, r);
+    checkConfig(MorphCachePolicy::Config{}, opt.readings, r);  // defaults: disabled, never clears
+    for (int i = 0; i < opt.configs; ++i) checkConfig(randomConfig(r), opt.readings, r);
+    std::printf("%d configs x %d readings checked\n", opt.configs + 2, opt.readings);
+
+    printShipped();
+
+    if (g_failed) std::printf("FAILED (%d checks)\n", g_failed);
+    return g_failed ? 1 : 0;
+}
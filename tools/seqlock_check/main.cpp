@@ -0,0 +1,182 @@
+// seqlock_check: stress test and contention bench for Seqlock, the cell behind the ChangeWeight
+// argument snapshot.
+//
+// Writers store generation-stamped values the size of the real snapshot (every word derived from
+// one generation) while readers load them as fast as they can; any load that mixes two
+// generations is a torn read. The same run is repeated on a mutex-guarded copy, the pattern the
+// snapshot used before, for comparison.
+//
+// Fails (exit 1) when a read is torn, a reader sees generations go backwards within one writer,
+// or the write count is off.
+//
+// usage: seqlock_check [--writers N] [--readers N] [--ms N]
+//   --writers <n>  writer threads, as RaceMenu callbacks (default 1)
+//   --readers <n>  reader threads, as weight lookups and drives (default 3)
+//   --ms <n>       duration of each run (default 500)
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "core/seqlock.h"
+
+namespace {
+    using MorphFixer::Seqlock;
+
+    struct Options {
+        int writers{1};
+        int readers{3};
+        int ms{500};
+    };
+
+    // About the size of the ChangeWeight snapshot (8 args x ~64 bytes). Word 0 is the stamp
+    // (generation, writer); every other word is derived from it.
+    struct Value {
+        static constexpr std::size_t WORDS = 64;
+        std::uint64_t words[WORDS];
+
+        void fill(std::uint32_t writer, std::uint64_t gen) noexcept {
+            words[0] = (gen << 8) | writer;
+            for (std::size_t i = 1; i < WORDS; ++i) words[i] = words[0] * 0x9E3779B97F4A7C15ull + i;
+        }
+        [[nodiscard]] bool consistent() const noexcept {
+            for (std::size_t i = 1; i < WORDS; ++i) {
+                if (words[i] != words[0] * 0x9E3779B97F4A7C15ull + i) return false;
+            }
+            return true;
+        }
+        [[nodiscard]] std::uint32_t writer() const noexcept { return static_cast<std::uint32_t>(words[0] & 0xFF); }
+        [[nodiscard]] std::uint64_t gen() const noexcept { return words[0] >> 8; }
+    };
+
+    // The snapshot's previous pattern: a copy under a mutex
+    struct MutexCell {
+        void store(const Value& v) {
+            std::lock_guard lk(m);
+            data = v;
+        }
+        bool load(Value& out) const {
+            std::lock_guard lk(m);
+            out = data;
+            return true;
+        }
+        mutable std::mutex m;
+        Value data{};
+    };
+
+    struct Result {
+        std::uint64_t writes{0};
+        std::uint64_t reads{0};
+        std::uint64_t torn{0};
+        std::uint64_t backwards{0};
+    };
+
+    template <class Cell>
+    Result run(Cell& cell, const Options& opt) {
+        std::atomic<bool> stop{false};
+        std::atomic<std::uint64_t> writes{0}, reads{0}, torn{0}, backwards{0};
+
+        {
+            Value v;
+            v.fill(0, 0);
+            cell.store(v);  // readers always find something
+        }
+        std::vector<std::thread> threads;
+        for (int w = 0; w < opt.writers; ++w) {
+            threads.emplace_back([&, w] {
+                Value v;
+                std::uint64_t gen = 1;
+                for (; !stop.load(std::memory_order_relaxed); ++gen) {
+                    v.fill(static_cast<std::uint32_t>(w), gen);
+                    cell.store(v);
+                }
+                writes.fetch_add(gen - 1);
+            });
+        }
+        for (int r = 0; r < opt.readers; ++r) {
+            threads.emplace_back([&] {
+                Value v;
+                std::vector<std::uint64_t> lastGen(static_cast<std::size_t>(opt.writers), 0);
+                std::uint64_t n = 0, bad = 0, back = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    if (!cell.load(v)) continue;
+                    ++n;
+                    if (!v.consistent()) {
+                        ++bad;
+                        continue;
+                    }
+                    const auto w = v.writer();
+                    if (w >= lastGen.size()) continue;
+                    if (v.gen() < lastGen[w]) ++back;
+                    lastGen[w] = v.gen();
+                }
+                reads.fetch_add(n);
+                torn.fetch_add(bad);
+                backwards.fetch_add(back);
+            });
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(opt.ms));
+        stop.store(true);
+        for (auto& t : threads) t.join();
+
+        return {writes.load(), reads.load(), torn.load(), backwards.load()};
+    }
+
+    void print(const char* name, const Result& r, const Options& opt) {
+        const double s = opt.ms / 1000.0;
+        std::printf("%-8s writes=%.2fM/s reads=%.2fM/s torn=%llu backwards=%llu\n", name, r.writes / s / 1e6,
+                    r.reads / s / 1e6, static_cast<unsigned long long>(r.torn),
+                    static_cast<unsigned long long>(r.backwards));
+    }
+
+    bool parseArgs(int argc, char** argv, Options& opt) {
+        for (int i = 1; i + 1 < argc; i += 2) {
+            const std::string_view a = argv[i];
+            const int v = std::atoi(argv[i + 1]);
+            if (a == "--writers") {
+                opt.writers = v;
+            } else if (a == "--readers") {
+                opt.readers = v;
+            } else if (a == "--ms") {
+                opt.ms = v;
+            } else {
+                return false;
+            }
+        }
+        return argc % 2 == 1 && opt.writers > 0 && opt.writers < 256 && opt.readers > 0 && opt.ms > 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        std::fprintf(stderr, "usage: %s [--writers N (max 255)] [--readers N] [--ms N]\n", argv[0]);
+        return 2;
+    }
+
+    std::printf("%d writer(s), %d reader(s), %zu-byte value, %d ms per run\n", opt.writers, opt.readers,
+                sizeof(Value), opt.ms);
+
+    Seqlock<Value> seq;
+    const auto s = run(seq, opt);
+    print("seqlock", s, opt);
+
+    MutexCell mtx;
+    const auto m = run(mtx, opt);
+    print("mutex", m, opt);
+
+    const bool countOk = seq.writes() == s.writes + 1;  // + the initial store
+    if (!countOk) {
+        std::printf("  CHECK FAILED: seqlock counted %u writes, writers made %llu\n", seq.writes(),
+                    static_cast<unsigned long long>(s.writes + 1));
+    }
+    const bool ok = !s.torn && !s.backwards && !m.torn && countOk;
+    if (!ok) std::printf("FAILED\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,302 @@
+#include "skee_mock.h"
+
+#include <algorithm>
+
+namespace MorphFixer::Tools {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        constexpr std::uint32_t MOCK_VERSION = 4;
+
+        // Sleeping is far too coarse for microsecond costs; spin instead.
+        void spinFor(std::chrono::nanoseconds d) noexcept {
+            if (d.count() <= 0) return;
+            const auto until = Clock::now() + d;
+            while (Clock::now() < until) {
+            }
+        }
+
+        inline std::string_view sv(const char* s) noexcept { return s ? std::string_view{s} : std::string_view{}; }
+    }
+
+    RE::TESObjectREFR* SkeeMock::actor(std::uint32_t formId) {
+        std::lock_guard lock(m_mutex);
+        auto& slot = m_handles[formId];
+        if (!slot) slot = std::make_unique<std::uint64_t>(formId);
+        return reinterpret_cast<RE::TESObjectREFR*>(slot.get());
+    }
+
+    std::uint64_t SkeeMock::totalCalls() const noexcept {
+        std::uint64_t n = 0;
+        for (const auto& c : m_calls) n += c.load();
+        return n;
+    }
+
+    void SkeeMock::resetCounters() noexcept {
+        for (auto& c : m_calls) c.store(0);
+        for (auto& f : m_failures) f.store(0);
+    }
+
+    std::size_t SkeeMock::cacheBytes() const {
+        std::lock_guard lock(m_mutex);
+        std::size_t n = 0;
+        for (const auto& [a, bytes] : m_cache) n += bytes;
+        return n;
+    }
+
+    std::size_t SkeeMock::cacheLimit() const {
+        std::lock_guard lock(m_mutex);
+        return m_cache_limit;
+    }
+
+    std::size_t SkeeMock::morphCount(RE::TESObjectREFR* actor) const {
+        std::lock_guard lock(m_mutex);
+        const auto it = m_morphs.find(actor);
+        if (it == m_morphs.end()) return 0;
+        std::size_t n = 0;
+        for (const auto& [name, keys] : it->second) n += keys.size();
+        return n;
+    }
+
+    void SkeeMock::clearAll() {
+        std::lock_guard lock(m_mutex);
+        m_morphs.clear();
+        m_strings.clear();
+        m_cache.clear();
+    }
+
+    std::string_view SkeeMock::methodName(Method m) noexcept {
+        static constexpr std::array<std::string_view, METHOD_COUNT> names{
+            "GetVersion",       "Revert",           "SetMorph",          "GetMorph",
+            "ClearMorph",       "GetBodyMorphs",    "ClearBodyMorphNames", "VisitMorphs",
+            "VisitKeys",        "VisitMorphValues", "ClearMorphs",       "ApplyVertexDiff",
+            "ApplyBodyMorphs",  "UpdateModelWeight", "SetCacheLimit",    "HasMorphs",
+            "EvaluateBodyMorphs", "HasBodyMorph",   "HasBodyMorphName",  "HasBodyMorphKey",
+            "ClearBodyMorphKeys", "VisitStrings",   "VisitActors",       "ClearMorphCache",
+        };
+        return index(m) < METHOD_COUNT ? names[index(m)] : "?";
+    }
+
+    bool SkeeMock::enter(Method m) noexcept {
+        const auto i = index(m);
+        const auto n = m_calls[i].fetch_add(1) + 1;
+        const auto& f = m_faults[i];
+        spinFor(f.latency);
+
+        bool fail = f.fail_every && n % f.fail_every == 0;
+        if (!fail && f.fail_rate > 0.0) {
+            // xorshift64*, shared across threads; exact sequence only matters single-threaded
+            auto x = m_rng.load(std::memory_order_relaxed), next = x;
+            do {
+                next = x;
+                next ^= next >> 12;
+                next ^= next << 25;
+                next ^= next >> 27;
+            } while (!m_rng.compare_exchange_weak(x, next, std::memory_order_relaxed));
+            const auto r = static_cast<double>((next * 0x2545F4914F6CDD1Dull) >> 11) * 0x1.0p-53;
+            fail = r < f.fail_rate;
+        }
+        if (fail) m_failures[i].fetch_add(1);
+        return !fail;
+    }
+
+    void SkeeMock::evictTo(std::size_t limit) {
+        std::size_t total = 0;
+        for (const auto& [a, bytes] : m_cache) total += bytes;
+        auto it = m_cache.begin();
+        for (; it != m_cache.end() && total > limit; ++it) total -= it->second;
+        m_cache.erase(m_cache.begin(), it);
+    }
+
+    // --- SKEE::IBodyMorphInterface ---
+
+    std::uint32_t SkeeMock::GetVersion() { return enter(Method::kGetVersion) ? MOCK_VERSION : 0; }
+
+    void SkeeMock::Revert() {
+        if (!enter(Method::kRevert)) return;
+        clearAll();
+    }
+
+    void SkeeMock::SetMorph(RE::TESObjectREFR* actor, const char* morphName, const char* morphKey, float relative) {
+        if (!enter(Method::kSetMorph) || !actor || sv(morphName).empty()) return;
+        std::lock_guard lock(m_mutex);
+        m_strings.emplace(sv(morphName));
+        m_strings.emplace(sv(morphKey));
+        auto& keys = m_morphs[actor][std::string{sv(morphName)}];
+        keys.insert_or_assign(std::string{sv(morphKey)}, relative);
+    }
+
+    float SkeeMock::GetMorph(RE::TESObjectREFR* actor, const char* morphName, const char* morphKey) {
+        if (!enter(Method::kGetMorph)) return 0.0f;
+        std::lock_guard lock(m_mutex);
+        const auto a = m_morphs.find(actor);
+        if (a == m_morphs.end()) return 0.0f;
+        const auto n = a->second.find(sv(morphName));
+        if (n == a->second.end()) return 0.0f;
+        const auto k = n->second.find(sv(morphKey));
+        return k == n->second.end() ? 0.0f : k->second;
+    }
+
+    void SkeeMock::ClearMorph(RE::TESObjectREFR* actor, const char* morphName, const char* morphKey) {
+        if (!enter(Method::kClearMorph)) return;
+        std::lock_guard lock(m_mutex);
+        const auto a = m_morphs.find(actor);
+        if (a == m_morphs.end()) return;
+        const auto n = a->second.find(sv(morphName));
+        if (n == a->second.end()) return;
+        if (const auto k = n->second.find(sv(morphKey)); k != n->second.end()) n->second.erase(k);
+        if (n->second.empty()) a->second.erase(n);
+        if (a->second.empty()) m_morphs.erase(a);
+    }
+
+    float SkeeMock::GetBodyMorphs(RE::TESObjectREFR* actor, const char* morphName) {
+        if (!enter(Method::kGetBodyMorphs)) return 0.0f;
+        std::lock_guard lock(m_mutex);
+        const auto a = m_morphs.find(actor);
+        if (a == m_morphs.end()) return 0.0f;
+        const auto n = a->second.find(sv(morphName));
+        if (n == a->second.end()) return 0.0f;
+        float sum = 0.0f;
+        for (const auto& [key, value] : n->second) sum += value;
+        return sum;
+    }
+
+    void SkeeMock::ClearBodyMorphNames(RE::TESObjectREFR* actor, const char* morphName) {
+        if (!enter(Method::kClearBodyMorphNames)) return;
+        std::lock_guard lock(m_mutex);
+        const auto a = m_morphs.find(actor);
+        if (a == m_morphs.end()) return;
+        if (const auto n = a->second.find(sv(morphName)); n != a->second.end()) a->second.erase(n);
+        if (a->second.empty()) m_morphs.erase(a);
+    }
+
+    void SkeeMock::VisitMorphs(RE::TESObjectREFR* actor, MorphVisitor& visitor) {
+        if (!enter(Method::kVisitMorphs)) return;
+        std::lock_guard lock(m_mutex);
+        const auto a = m_morphs.find(actor);
+        if (a == m_morphs.end()) return;
+        for (const auto& [name, keys] : a->second) visitor.Visit(actor, name.c_str());
+    }
+
+    void SkeeMock::VisitKeys(RE::TESObjectREFR* actor, const char* name, MorphKeyVisitor& visitor) {
+        if (!enter(Method::kVisitKeys)) return;
+        std::lock_guard lock(m_mutex);
+        const auto a = m_morphs.find(actor);
+        if (a == m_morphs.end()) return;
+        const auto n = a->second.find(sv(name));
+        if (n == a->second.end()) return;
+        for (const auto& [key, value] : n->second) visitor.Visit(key.c_str(), value);
+    }
+
+    void SkeeMock::VisitMorphValues(RE::TESObjectREFR* actor, MorphValueVisitor& visitor) {
+        if (!enter(Method::kVisitMorphValues)) return;
+        std::lock_guard lock(m_mutex);
+        const auto a = m_morphs.find(actor);
+        if (a == m_morphs.end()) return;
+        for (const auto& [name, keys] : a->second) {
+            for (const auto& [key, value] : keys) visitor.Visit(actor, name.c_str(), key.c_str(), value);
+        }
+    }
+
+    void SkeeMock::ClearMorphs(RE::TESObjectREFR* actor) {
+        if (!enter(Method::kClearMorphs)) return;
+        std::lock_guard lock(m_mutex);
+        m_morphs.erase(actor);
+    }
+
+    void SkeeMock::ApplyVertexDiff(RE::TESObjectREFR*, RE::NiAVObject*, bool) {
+        // No geometry host-side; counted (and timed) only
+        enter(Method::kApplyVertexDiff);
+    }
+
+    void SkeeMock::ApplyBodyMorphs(RE::TESObjectREFR* refr, bool) {
+        if (!enter(Method::kApplyBodyMorphs) || !refr) return;
+        std::lock_guard lock(m_mutex);
+        std::erase_if(m_cache, [refr](const auto& e) { return e.first == refr; });
+        const auto a = m_morphs.find(refr);
+        if (a == m_morphs.end()) return;
+        m_cache.emplace_back(refr, a->second.size() * CACHE_BYTES_PER_MORPH);
+        evictTo(m_cache_limit);
+    }
+
+    void SkeeMock::UpdateModelWeight(RE::TESObjectREFR*, bool) { enter(Method::kUpdateModelWeight); }
+
+    void SkeeMock::SetCacheLimit(std::size_t limit) {
+        if (!enter(Method::kSetCacheLimit)) return;
+        std::lock_guard lock(m_mutex);
+        m_cache_limit = limit;
+        evictTo(limit);
+    }
+
+    bool SkeeMock::HasMorphs(RE::TESObjectREFR* actor) {
+        if (!enter(Method::kHasMorphs)) return false;
+        std::lock_guard lock(m_mutex);
+        return m_morphs.contains(actor);
+    }
+
+    std::uint32_t SkeeMock::EvaluateBodyMorphs(RE::TESObjectREFR* actor) {
+        if (!enter(Method::kEvaluateBodyMorphs)) return 0;
+        std::lock_guard lock(m_mutex);
+        const auto a = m_morphs.find(actor);
+        return a == m_morphs.end() ? 0 : static_cast<std::uint32_t>(a->second.size());
+    }
+
+    bool SkeeMock::HasBodyMorph(RE::TESObjectREFR* actor, const char* morphName, const char* morphKey) {
+        if (!enter(Method::kHasBodyMorph)) return false;
+        std::lock_guard lock(m_mutex);
+        const auto a = m_morphs.find(actor);
+        if (a == m_morphs.end()) return false;
+        const auto n = a->second.find(sv(morphName));
+        return n != a->second.end() && n->second.contains(sv(morphKey));
+    }
+
+    bool SkeeMock::HasBodyMorphName(RE::TESObjectREFR* actor, const char* morphName) {
+        if (!enter(Method::kHasBodyMorphName)) return false;
+        std::lock_guard lock(m_mutex);
+        const auto a = m_morphs.find(actor);
+        return a != m_morphs.end() && a->second.contains(sv(morphName));
+    }
+
+    bool SkeeMock::HasBodyMorphKey(RE::TESObjectREFR* actor, const char* morphKey) {
+        if (!enter(Method::kHasBodyMorphKey)) return false;
+        std::lock_guard lock(m_mutex);
+        const auto a = m_morphs.find(actor);
+        if (a == m_morphs.end()) return false;
+        return std::any_of(a->second.begin(), a->second.end(),
+                           [k = sv(morphKey)](const auto& n) { return n.second.contains(k); });
+    }
+
+    void SkeeMock::ClearBodyMorphKeys(RE::TESObjectREFR* actor, const char* morphKey) {
+        if (!enter(Method::kClearBodyMorphKeys)) return;
+        std::lock_guard lock(m_mutex);
+        const auto a = m_morphs.find(actor);
+        if (a == m_morphs.end()) return;
+        for (auto n = a->second.begin(); n != a->second.end();) {
+            if (const auto k = n->second.find(sv(morphKey)); k != n->second.end()) n->second.erase(k);
+            n = n->second.empty() ? a->second.erase(n) : std::next(n);
+        }
+        if (a->second.empty()) m_morphs.erase(a);
+    }
+
+    void SkeeMock::VisitStrings(StringVisitor& visitor) {
+        if (!enter(Method::kVisitStrings)) return;
+        std::lock_guard lock(m_mutex);
+        for (const auto& s : m_strings) visitor.Visit(s.c_str());
+    }
+
+    void SkeeMock::VisitActors(ActorVisitor& visitor) {
+        if (!enter(Method::kVisitActors)) return;
+        std::lock_guard lock(m_mutex);
+        for (const auto& [a, names] : m_morphs) visitor.Visit(a);
+    }
+
+    std::size_t SkeeMock::ClearMorphCache() {
+        if (!enter(Method::kClearMorphCache)) return 0;
+        std::lock_guard lock(m_mutex);
+        std::size_t freed = 0;
+        for (const auto& [a, bytes] : m_cache) freed += bytes;
+        m_cache.clear();
+        return freed;
+    }
+
+}  // namespace MorphFixer::Tools
@@ -0,0 +1,152 @@
+#pragma once
+
+// skee_mock: in-memory SKEE::IBodyMorphInterface for host builds (tools, benchmarks).
+//
+// Actors are opaque handles from actor(); they are never dereferenced, so nothing from CommonLib
+// is needed. Morph values live in ordered maps (actor -> name -> key -> value), names and keys are
+// also kept in a string table for VisitStrings, as SKEE does. ApplyBodyMorphs models the vertex
+// diff cache so SetCacheLimit / ClearMorphCache have something to act on.
+//
+// Every interface call is counted. Per method, a call can be given a busy-wait latency (to stand
+// in for SKEE's cost) and fail either every Nth call or at a seeded rate; a failed call has no
+// effect and getters return their empty value, which is how SKEE treats calls it rejects.
+// All methods are safe to call from several threads; visitors may call back into the mock.
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "skee.h"
+
+namespace MorphFixer::Tools {
+
+    class SkeeMock final : public SKEE::IBodyMorphInterface {
+    public:
+        enum class Method : std::uint8_t {
+            kGetVersion,
+            kRevert,
+            kSetMorph,
+            kGetMorph,
+            kClearMorph,
+            kGetBodyMorphs,
+            kClearBodyMorphNames,
+            kVisitMorphs,
+            kVisitKeys,
+            kVisitMorphValues,
+            kClearMorphs,
+            kApplyVertexDiff,
+            kApplyBodyMorphs,
+            kUpdateModelWeight,
+            kSetCacheLimit,
+            kHasMorphs,
+            kEvaluateBodyMorphs,
+            kHasBodyMorph,
+            kHasBodyMorphName,
+            kHasBodyMorphKey,
+            kClearBodyMorphKeys,
+            kVisitStrings,
+            kVisitActors,
+            kClearMorphCache,
+            kCount
+        };
+        static constexpr std::size_t METHOD_COUNT = static_cast<std::size_t>(Method::kCount);
+
+        struct Fault {
+            std::chrono::nanoseconds latency{0};  // busy-wait per call, before the call takes effect
+            std::uint32_t fail_every{0};          // fail calls N, 2N, ... of this method (0 = never)
+            double fail_rate{0.0};                // and/or fail with this probability [0..1]
+        };
+
+        // Cache model: each morph name an actor has costs this much once ApplyBodyMorphs built it
+        static constexpr std::size_t CACHE_BYTES_PER_MORPH = 64 * 1024;
+
+        explicit SkeeMock(std::uint64_t seed = 0x9E3779B97F4A7C15ull) noexcept : m_rng(seed | 1) {}
+
+        // Stable opaque handle for a form id; the same id always yields the same handle.
+        RE::TESObjectREFR* actor(std::uint32_t formId);
+
+        // Setup-time configuration (not synchronised with calls in flight).
+        void setFault(Method m, const Fault& f) noexcept { m_faults[index(m)] = f; }
+        void setFaultAll(const Fault& f) noexcept { m_faults.fill(f); }
+
+        [[nodiscard]] std::uint64_t calls(Method m) const noexcept { return m_calls[index(m)].load(); }
+        [[nodiscard]] std::uint64_t failures(Method m) const noexcept { return m_failures[index(m)].load(); }
+        [[nodiscard]] std::uint64_t totalCalls() const noexcept;
+        void resetCounters() noexcept;
+
+        [[nodiscard]] std::size_t cacheBytes() const;
+        [[nodiscard]] std::size_t cacheLimit() const;
+        [[nodiscard]] std::size_t morphCount(RE::TESObjectREFR* actor) const;  // (name, key) entries
+
+        // Drop all actors, values, strings and cache (counters and faults are kept).
+        void clearAll();
+
+        static std::string_view methodName(Method m) noexcept;
+
+        // --- SKEE::IBodyMorphInterface ---
+        std::uint32_t GetVersion() override;
+        void Revert() override;
+
+        void SetMorph(RE::TESObjectREFR* actor, const char* morphName, const char* morphKey, float relative) override;
+        float GetMorph(RE::TESObjectREFR* actor, const char* morphName, const char* morphKey) override;
+        void ClearMorph(RE::TESObjectREFR* actor, const char* morphName, const char* morphKey) override;
+
+        float GetBodyMorphs(RE::TESObjectREFR* actor, const char* morphName) override;
+        void ClearBodyMorphNames(RE::TESObjectREFR* actor, const char* morphName) override;
+
+        void VisitMorphs(RE::TESObjectREFR* actor, MorphVisitor& visitor) override;
+        void VisitKeys(RE::TESObjectREFR* actor, const char* name, MorphKeyVisitor& visitor) override;
+        void VisitMorphValues(RE::TESObjectREFR* actor, MorphValueVisitor& visitor) override;
+
+        void ClearMorphs(RE::TESObjectREFR* actor) override;
+
+        void ApplyVertexDiff(RE::TESObjectREFR* refr, RE::NiAVObject* rootNode, bool erase = false) override;
+
+        void ApplyBodyMorphs(RE::TESObjectREFR* refr, bool deferUpdate = true) override;
+        void UpdateModelWeight(RE::TESObjectREFR* refr, bool immediate = false) override;
+
+        void SetCacheLimit(std::size_t limit) override;
+        bool HasMorphs(RE::TESObjectREFR* actor) override;
+        std::uint32_t EvaluateBodyMorphs(RE::TESObjectREFR* actor) override;
+
+        bool HasBodyMorph(RE::TESObjectREFR* actor, const char* morphName, const char* morphKey) override;
+        bool HasBodyMorphName(RE::TESObjectREFR* actor, const char* morphName) override;
+        bool HasBodyMorphKey(RE::TESObjectREFR* actor, const char* morphKey) override;
+        void ClearBodyMorphKeys(RE::TESObjectREFR* actor, const char* morphKey) override;
+        void VisitStrings(StringVisitor& visitor) override;
+        void VisitActors(ActorVisitor& visitor) override;
+        std::size_t ClearMorphCache() override;
+
+    private:
+        using Keys = std::map<std::string, float, std::less<>>;
+        using Names = std::map<std::string, Keys, std::less<>>;
+
+        static constexpr std::size_t index(Method m) noexcept { return static_cast<std::size_t>(m); }
+
+        // Count the call, spend its latency, and roll its failure. False = the call fails.
+        bool enter(Method m) noexcept;
+        void evictTo(std::size_t limit);  // caller holds m_mutex
+
+        mutable std::recursive_mutex m_mutex;
+        std::map<RE::TESObjectREFR*, Names> m_morphs;
+        std::set<std::string, std::less<>> m_strings;
+        std::map<std::uint32_t, std::unique_ptr<std::uint64_t>> m_handles;  // form id -> handle storage
+        std::vector<std::pair<RE::TESObjectREFR*, std::size_t>> m_cache;   // least recently applied first
+        std::size_t m_cache_limit{SIZE_MAX};
+
+        std::array<Fault, METHOD_COUNT> m_faults{};
+        std::array<std::atomic<std::uint64_t>, METHOD_COUNT> m_calls{};
+        std::array<std::atomic<std::uint64_t>, METHOD_COUNT> m_failures{};
+        std::atomic<std::uint64_t> m_rng;
+    };
+
+}  // namespace MorphFixer::Tools
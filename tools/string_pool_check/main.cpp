@@ -0,0 +1,189 @@
+// string_pool_check: checks Helpers::StringPool against a reference std::unordered_map and times
+// both on morph-name-like strings.
+//
+//   check  - random strings (empty, short, morph-name length, longer than an arena block, with
+//            embedded NULs, many repeats) interned and looked up; ids must be dense and match the
+//            reference, find() must never insert, and nameOf / c_str pointers taken early must
+//            still hold after the table and arena grew
+//   bench  - ns per intern / find of already-known names, and per first insert, vs the map
+//
+// Exits 1 on any mismatch.
+//
+// usage: string_pool_check [--strings N] [--iters N]
+//   --strings <n>  distinct strings in the check (default 50000)
+//   --iters <n>    lookups per timing (default 2000000)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "helpers/string_pool.h"
+
+namespace {
+    using MorphFixer::Helpers::StringPool;
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        int strings{50000};
+        int iters{2000000};
+    };
+
+    int g_failed = 0;
+
+    void check(bool ok, const char* what) {
+        if (ok) return;
+        std::printf("  CHECK FAILED: %s\n", what);
+        ++g_failed;
+    }
+
+    template <class Fn>
+    double nsPerCall(int iters, Fn&& fn) {
+        const auto t0 = Clock::now();
+        for (int i = 0; i < iters; ++i) fn(i);
+        return std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / iters;
+    }
+
+    unsigned next(unsigned& r) {
+        r = r * 1664525u + 1013904223u;
+        return r >> 8;
+    }
+
+    // Mostly morph-name shaped ("RaceMenuMorphsCBBE12", 10-40 chars), plus the awkward ones
+    std::string makeString(unsigned& r) {
+        switch (next(r) % 16) {
+            case 0:
+                return {};
+            case 1:
+                return std::string(1 + next(r) % 7, static_cast<char>('a' + next(r) % 3));
+            case 2: {
+                std::string s = "Morph" + std::to_string(next(r) % 500);
+                s.insert(s.begin() + 2, '\0');
+                return s;
+            }
+            case 3:
+                if (next(r) % 64 == 0) return std::string(StringPool::BLOCK_BYTES + next(r) % 100, 'x');
+                [[fallthrough]];
+            default:
+                return (next(r) & 1 ? "RaceMenuMorphsCBBE" : "Vagina_Morph_") + std::to_string(next(r) % 200000);
+        }
+    }
+
+    void checkReference(const Options& opt) {
+        StringPool pool;
+        std::unordered_map<std::string, StringPool::Id> ref;
+        std::vector<std::string> byId;
+        struct Early {
+            StringPool::Id id;
+            const char* chars;
+        };
+        std::vector<Early> early;
+
+        bool idsMatch = true, findMatch = true, roundTrip = true, missNoInsert = true;
+        unsigned r = 0x57u;
+        while (ref.size() < static_cast<std::size_t>(opt.strings)) {
+            const auto s = makeString(r);
+            const auto expected = ref.emplace(s, static_cast<StringPool::Id>(ref.size())).first->second;
+            if (expected == byId.size()) byId.push_back(s);
+
+            const auto before = pool.size();
+            const auto probe = pool.find(s);
+            missNoInsert = missNoInsert && pool.size() == before;
+            findMatch = findMatch && probe == (expected < before ? expected : StringPool::INVALID_ID);
+
+            const auto id = pool.intern(s);
+            idsMatch = idsMatch && id == expected && pool.size() == ref.size();
+            if (early.size() < 1000 && id == before) early.push_back({id, pool.c_str(id)});
+        }
+        for (StringPool::Id id = 0; id < byId.size(); ++id) {
+            const auto& s = byId[id];
+            roundTrip = roundTrip && pool.nameOf(id) == s && pool.find(s) == id &&
+                        std::memcmp(pool.c_str(id), s.data(), s.size()) == 0 && pool.c_str(id)[s.size()] == '\0';
+        }
+        bool stable = true;
+        for (const auto& e : early) stable = stable && pool.c_str(e.id) == e.chars;
+
+        std::printf("check: %zu distinct string(s), %zu KiB held\n", pool.size(), pool.memoryBytes() / 1024);
+        check(idsMatch, "intern returns the reference id (dense, first-seen order)");
+        check(findMatch && missNoInsert, "find returns the id or INVALID_ID and never inserts");
+        check(roundTrip, "nameOf / c_str / find round-trip every id");
+        check(stable, "c_str pointers survive table and arena growth");
+        const auto unknown = static_cast<StringPool::Id>(pool.size());
+        check(pool.nameOf(unknown).empty() && *pool.c_str(unknown) == 0, "unknown ids give an empty name");
+
+        StringPool moved = std::move(pool);
+        check(moved.size() == byId.size() && moved.find(byId.back()) == byId.size() - 1,
+              "a moved-to pool keeps its ids");
+    }
+
+    void bench(const Options& opt) {
+        // One body preset's names: 120 morphs x a few keys, looked up over and over
+        std::vector<std::string> names;
+        for (int i = 0; i < 480; ++i) names.push_back("RaceMenuMorphsCBBE_Slider" + std::to_string(i * 37));
+        const auto pick = [&](int i) -> const std::string& {
+            return names[static_cast<std::size_t>(i) % names.size()];
+        };
+
+        StringPool pool;
+        std::unordered_map<std::string, StringPool::Id> map;
+        for (const auto& n : names) map.emplace(n, pool.intern(n));
+
+        volatile std::uint32_t sink = 0;
+        const auto poolIntern = nsPerCall(opt.iters, [&](int i) { sink = sink + pool.intern(pick(i)); });
+        const auto poolFind = nsPerCall(opt.iters, [&](int i) { sink = sink + pool.find(pick(i)); });
+        const auto mapFind = nsPerCall(opt.iters, [&](int i) { sink = sink + map.find(pick(i))->second; });
+
+        // First inserts: a fresh pool / map per round of names
+        const int rounds = std::max(1, opt.iters / static_cast<int>(names.size()) / 20);
+        const auto poolInsert = nsPerCall(rounds, [&](int) {
+            StringPool p;
+            for (const auto& n : names) sink = sink + p.intern(n);
+        }) / static_cast<double>(names.size());
+        const auto mapInsert = nsPerCall(rounds, [&](int) {
+            std::unordered_map<std::string, StringPool::Id> m;
+            for (const auto& n : names) {
+                sink = sink + m.emplace(n, static_cast<StringPool::Id>(m.size())).first->second;
+            }
+        }) / static_cast<double>(names.size());
+
+        std::printf("bench: %zu names of ~28 chars\n", names.size());
+        std::printf("  known name: StringPool intern %.1f ns, find %.1f ns; unordered_map find %.1f ns\n", poolIntern,
+                    poolFind, mapFind);
+        std::printf("  first insert: StringPool %.1f ns, unordered_map %.1f ns\n", poolInsert, mapInsert);
+    }
+
+    bool parseArgs(int argc, char** argv, Options& opt) {
+        for (int i = 1; i + 1 < argc; i += 2) {
+            const std::string_view a = argv[i];
+            const int v = std::atoi(argv[i + 1]);
+            if (a == "--strings") {
+                opt.strings = v;
+            } else if (a == "--iters") {
+                opt.iters = v;
+            } else {
+                return false;
+            }
+        }
+        return argc % 2 == 1 && opt.strings > 0 && opt.iters > 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        std::fprintf(stderr, "usage: %s [--strings N] [--iters N]\n", argv[0]);
+        return 2;
+    }
+
+    checkReference(opt);
+    bench(opt);
+
+    if (g_failed) std::printf("%d check(s) failed\n", g_failed);
+    return g_failed ? 1 : 0;
+}
@@ -0,0 +1,252 @@
+// tail_flush_bench: worker wakeups and tail-flush lateness for the shared TimerWheel, against the
+// polling loop the tail flush used before it.
+//
+// The same scripted menu session runs through a CadenceEngine on a real clock twice:
+//   wheel - the tail deadline goes to TimerWheel::armAt, as in the game
+//   poll  - the old tail thread: 5 ms naps while armed-but-idle, sleeps of the remaining time
+//           (at least 1 ms) once a deadline is near, 10 ms naps while the menu is closed
+// Each session is --sessions slider drags (an event every frame for --drag-ms, then --idle-ms of
+// nothing, time for the tail flush to run), followed by --closed-ms with the menu closed.
+//
+// Reported per variant: worker wakeups in total and per second of idle, and the tail delay (tail
+// deadline -> the worker noticing it) from the engine's own histogram. Exits 1 when a variant
+// flushes a different number of tails than drags were made.
+//
+// usage: tail_flush_bench [--sessions N] [--drag-ms N] [--idle-ms N] [--closed-ms N]
+//   --sessions <n>   drags per variant (default 5)
+//   --drag-ms <n>    length of each drag (default 300)
+//   --idle-ms <n>    pause after each drag (default 700)
+//   --closed-ms <n>  menu closed after the drags (default 1000)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <string_view>
+#include <thread>
+
+#include "core/timer_wheel.h"
+#include "features/cadence_engine.h"
+
+namespace {
+    using MorphFixer::CadenceEngine;
+    using MorphFixer::TimerWheel;
+    using MorphFixer::UiCommand;
+    using MorphFixer::UiOp;
+    using namespace std::chrono_literals;
+
+    struct Options {
+        int sessions{5};
+        int drag_ms{300};
+        int idle_ms{700};
+        int closed_ms{1000};
+    };
+
+    int g_failed = 0;
+
+    void check(bool ok, const char* what) {
+        if (ok) return;
+        if (++g_failed <= 20) std::printf("  CHECK FAILED: %s\n", what);
+    }
+
+    struct SteadyClock final : CadenceEngine::Clock {
+        [[nodiscard]] long long nowNs() const noexcept override { return TimerWheel::nowNs(); }
+    };
+
+    struct FixedWeight final : CadenceEngine::WeightSource {
+        [[nodiscard]] double currentNorm() noexcept override { return 0.5; }
+    };
+
+    struct IdleDriver final : CadenceEngine::WeightDriver {
+        [[nodiscard]] bool ready() noexcept override { return false; }
+        bool drive(double) noexcept override { return true; }
+        bool nudgeRestore(double, double) noexcept override { return true; }
+        [[nodiscard]] bool canRefresh() noexcept override { return false; }
+        bool refresh() noexcept override { return true; }
+        [[nodiscard]] bool morphsChanged() noexcept override { return true; }
+    };
+
+    // Runs tasks inline and counts the tail flushes; where the tail deadline goes is up to Timer
+    template <class Timer>
+    struct BenchSink final : CadenceEngine::TaskSink {
+        CadenceEngine* engine{nullptr};
+        Timer* timer{nullptr};
+        std::atomic<int> tails{0};
+
+        bool submit(const UiCommand& cmd) noexcept override {
+            if (cmd.op == UiOp::kTail) tails.fetch_add(1, std::memory_order_relaxed);
+            engine->runTask(cmd);
+            return true;
+        }
+        bool submitSettle(const UiCommand&) noexcept override { return false; }
+        void armTail(long long dueNs) noexcept override { timer->arm(dueNs); }
+        void cancelTail() noexcept override { timer->cancel(); }
+        [[nodiscard]] std::size_t depth() const noexcept override { return 0; }
+    };
+
+    struct WheelTimer {
+        CadenceEngine* engine{nullptr};
+        TimerWheel::TimerId id{TimerWheel::INVALID_TIMER};
+
+        void arm(long long dueNs) { TimerWheel::get().armAt(id, dueNs); }
+        void cancel() { TimerWheel::get().cancel(id); }
+        void setEnabled(bool) {}
+        [[nodiscard]] std::uint64_t wakeups() const { return TimerWheel::get().wakeups(); }
+        void stop() {}
+    };
+
+    // The pre-wheel tail thread, as it was: polls the armed deadline
+    struct PollTimer {
+        CadenceEngine* engine{nullptr};
+        std::atomic<long long> due{-1};
+        std::atomic<bool> enabled{false};
+        std::atomic<bool> quit{false};
+        std::atomic<std::uint64_t> loops{0};
+        std::thread worker;
+
+        void start() {
+            worker = std::thread([this] {
+                while (!quit.load(std::memory_order_relaxed)) {
+                    loops.fetch_add(1, std::memory_order_relaxed);
+                    if (!enabled.load(std::memory_order_relaxed)) {
+                        std::this_thread::sleep_for(10ms);
+                        continue;
+                    }
+                    const auto d = due.load(std::memory_order_relaxed);
+                    if (d > 0) {
+                        const auto now = TimerWheel::nowNs();
+                        if (now >= d) {
+                            due.store(-1, std::memory_order_relaxed);
+                            engine->onTailTimer();  // may re-arm (idle gap not reached yet)
+                            continue;
+                        }
+                        const auto remainMs = std::max(1LL, (d - now) / 1'000'000LL);
+                        std::this_thread::sleep_for(std::chrono::milliseconds(remainMs));
+                        continue;
+                    }
+                    std::this_thread::sleep_for(5ms);
+                }
+            });
+        }
+
+        void arm(long long dueNs) { due.store(dueNs, std::memory_order_relaxed); }
+        void cancel() { due.store(-1, std::memory_order_relaxed); }
+        void setEnabled(bool e) { enabled.store(e, std::memory_order_relaxed); }
+        [[nodiscard]] std::uint64_t wakeups() const { return loops.load(std::memory_order_relaxed); }
+        void stop() {
+            quit.store(true);
+            worker.join();
+        }
+    };
+
+    struct Result {
+        std::uint64_t wakeups{0};
+        std::uint64_t idleWakeups{0};  // during the drags' idle pauses and with the menu closed
+        double idleSeconds{0};
+        int tails{0};
+        MorphFixer::Helpers::LogLinearHistogram::Summary tailDelay{};
+    };
+
+    template <class Timer>
+    Result run(const Options& opt, Timer& timer) {
+        SteadyClock clock;
+        FixedWeight weights;
+        IdleDriver driver;
+        BenchSink<Timer> sink;
+        CadenceEngine engine(clock, sink, weights, driver);
+        sink.engine = &engine;
+        sink.timer = &timer;
+        timer.engine = &engine;
+
+        MorphFixer::AdaptiveThrottle::Config cfg;
+        cfg.enabled = false;  // fixed 100 ms throttle / 150 ms idle gap: the same deadlines for both
+        engine.configure(cfg);
+        engine.setEnabled(true);
+        timer.setEnabled(true);
+
+        const auto slider = MorphFixer::Helpers::EventNames::resolve("ChangeDoubleMorph");
+        Result r;
+        const auto w0 = timer.wakeups();
+        for (int s = 0; s < opt.sessions; ++s) {
+            const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(opt.drag_ms);
+            while (std::chrono::steady_clock::now() < end) {
+                engine.onEvent(slider, std::nullopt);
+                std::this_thread::sleep_for(16ms);
+            }
+            const auto wIdle = timer.wakeups();
+            std::this_thread::sleep_for(std::chrono::milliseconds(opt.idle_ms));
+            r.idleWakeups += timer.wakeups() - wIdle;
+        }
+        engine.setEnabled(false);
+        engine.reset();
+        timer.setEnabled(false);
+        const auto wClosed = timer.wakeups();
+        std::this_thread::sleep_for(std::chrono::milliseconds(opt.closed_ms));
+        r.idleWakeups += timer.wakeups() - wClosed;
+
+        r.wakeups = timer.wakeups() - w0;
+        r.idleSeconds = static_cast<double>(opt.sessions * opt.idle_ms + opt.closed_ms) / 1000.0;
+        r.tails = sink.tails.load();
+        r.tailDelay = engine.latency().tailDelay.summary();
+        timer.stop();
+        return r;
+    }
+
+    void print(const char* name, const Result& r) {
+        const auto ms = [](std::uint64_t ns) { return static_cast<double>(ns) / 1e6; };
+        std::printf("%-5s wakeups=%-5llu idle=%6.1f/s  tails=%d  tail delay p50=%.3f ms p99=%.3f ms max=%.3f ms\n",
+                    name, static_cast<unsigned long long>(r.wakeups),
+                    static_cast<double>(r.idleWakeups) / r.idleSeconds, r.tails, ms(r.tailDelay.p50),
+                    ms(r.tailDelay.p99), ms(r.tailDelay.max));
+    }
+
+    bool parseArgs(int argc, char** argv, Options& opt) {
+        for (int i = 1; i + 1 < argc; i += 2) {
+            const std::string_view a = argv[i];
+            const int v = std::atoi(argv[i + 1]);
+            if (a == "--sessions") {
+                opt.sessions = v;
+            } else if (a == "--drag-ms") {
+                opt.drag_ms = v;
+            } else if (a == "--idle-ms") {
+                opt.idle_ms = v;
+            } else if (a == "--closed-ms") {
+                opt.closed_ms = v;
+            } else {
+                return false;
+            }
+        }
+        // The idle pause has to outlast the idle gap, or drags merge into one tail
+        return argc % 2 == 1 && opt.sessions > 0 && opt.drag_ms > 0 && opt.idle_ms >= 300 && opt.closed_ms >= 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        std::fprintf(stderr, "usage: %s [--sessions N] [--drag-ms N] [--idle-ms N>=300] [--closed-ms N]\n", argv[0]);
+        return 2;
+    }
+    std::printf("%d drags of %d ms, %d ms idle after each, %d ms menu closed\n", opt.sessions, opt.drag_ms,
+                opt.idle_ms, opt.closed_ms);
+
+    PollTimer poll;
+    poll.start();
+    const auto p = run(opt, poll);
+    print("poll", p);
+
+    WheelTimer wheel;
+    wheel.id = TimerWheel::get().create([&wheel] { wheel.engine->onTailTimer(); });
+    const auto w = run(opt, wheel);
+    print("wheel", w);
+    TimerWheel::get().shutdown();
+
+    check(p.tails == opt.sessions, "poll: one tail flush per drag");
+    check(w.tails == opt.sessions, "wheel: one tail flush per drag");
+
+    if (g_failed) std::printf("FAILED (%d checks)\n", g_failed);
+    return g_failed ? 1 : 0;
+}
@@ -0,0 +1,228 @@
+// timer_wheel_check: fires randomised timers through the shared TimerWheel and checks them
+// against their own deadlines, the reference a wheel has to meet.
+//
+// Timers are armed from several threads with delays spread over all three wheel levels, some
+// re-armed before they fire and some cancelled. Fails (exit 1) when a timer
+//   - fires before its deadline (the wheel promises never to fire early)
+//   - fires later than --late-ms after it (worker stalled or a cascade lost it)
+//   - fires more than once, fires after cancel(), or never fires
+//   - fires after shutdown()
+//
+// Before the rounds it prints arm/cancel throughput on the same timers, with deadlines far enough
+// out that nothing fires: re-arming one armed timer (a drag storm moving the tail deadline), and
+// arm + cancel pairs spread over all timers and wheel levels.
+//
+// usage: timer_wheel_check [--timers N] [--max-ms N] [--late-ms N] [--rounds N] [--ops N]
+//   --timers <n>   timers per round (default 200, at most TimerWheel::MAX_TIMERS)
+//   --max-ms <n>   longest delay; past 4096 ms timers go through level 2 (default 5000)
+//   --late-ms <n>  lateness allowed for scheduling noise (default 25)
+//   --rounds <n>   rounds, each re-using the same timers (default 3)
+//   --ops <n>      operations per throughput run (default 1000000)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "core/timer_wheel.h"
+
+namespace {
+    using MorphFixer::TimerWheel;
+
+    struct Options {
+        int timers{200};
+        int max_ms{5000};
+        int late_ms{25};
+        int rounds{3};
+        int ops{1000000};
+    };
+
+    enum class Plan : std::uint8_t { kFire, kRearm, kCancel };
+
+    struct Slot {
+        TimerWheel::TimerId id{TimerWheel::INVALID_TIMER};
+        Plan plan{Plan::kFire};
+        std::atomic<long long> due{0};
+        std::atomic<long long> fired_at{-1};
+        std::atomic<int> fires{0};
+    };
+
+    bool parseArgs(int argc, char** argv, Options& opt) {
+        for (int i = 1; i + 1 < argc; i += 2) {
+            const std::string_view a = argv[i];
+            const int v = std::atoi(argv[i + 1]);
+            if (a == "--timers") {
+                opt.timers = v;
+            } else if (a == "--max-ms") {
+                opt.max_ms = v;
+            } else if (a == "--late-ms") {
+                opt.late_ms = v;
+            } else if (a == "--rounds") {
+                opt.rounds = v;
+            } else if (a == "--ops") {
+                opt.ops = v;
+            } else {
+                return false;
+            }
+        }
+        return argc % 2 == 1 && opt.timers > 0 && opt.timers <= static_cast<int>(TimerWheel::MAX_TIMERS) &&
+               opt.max_ms > 0 && opt.rounds > 0 && opt.ops > 0;
+    }
+
+    // ns per call of op(i) for i in [0, ops)
+    template <class Op>
+    double timeOps(int ops, Op&& op) {
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < ops; ++i) op(i);
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / ops;
+    }
+
+    // Arm/cancel cost on the caller's side; returns false when a timer fired or stayed armed
+    bool throughput(TimerWheel& wheel, const std::vector<Slot>& slots, int ops) {
+        constexpr long long FAR_NS = 10'000'000'000LL;  // 10 s: level 2, never reached during the run
+        const auto n = slots.size();
+        const auto base = TimerWheel::nowNs() + FAR_NS;
+
+        const auto tail = slots[0].id;
+        const double rearmNs = timeOps(ops, [&](int i) { wheel.armAt(tail, base + (i % 4096) * 1'000'000LL); });
+        wheel.cancel(tail);
+
+        const double pairNs = timeOps(ops, [&](int i) {
+            const auto id = slots[static_cast<std::size_t>(i) % n].id;
+            wheel.armAt(id, base + static_cast<long long>(i % 200'000) * 10'000LL);
+            wheel.cancel(id);
+        });
+
+        // Cancel on its own, over a pool that is half armed
+        for (std::size_t i = 0; i < n; i += 2) wheel.armAt(slots[i].id, base + static_cast<long long>(i) * 1'000'000LL);
+        const double cancelNs = timeOps(static_cast<int>(n), [&](int i) { wheel.cancel(slots[static_cast<std::size_t>(i)].id); });
+
+        std::printf("throughput: re-arm %.1f ns (%.1f M/s)  arm+cancel %.1f ns/pair (%.1f M/s)  cancel %.1f ns\n",
+                    rearmNs, 1e3 / rearmNs, pairNs, 1e3 / pairNs, cancelNs);
+
+        bool ok = true;
+        for (const auto& s : slots) ok = ok && !wheel.armed(s.id) && s.fires.load() == 0;
+        return ok;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        std::fprintf(stderr, "usage: %s [--timers N] [--max-ms N] [--late-ms N] [--rounds N] [--ops N]\n", argv[0]);
+        return 2;
+    }
+
+    auto& wheel = TimerWheel::get();
+    std::vector<Slot> slots(static_cast<std::size_t>(opt.timers));
+    for (auto& s : slots) {
+        s.id = wheel.create([&s] {
+            s.fired_at.store(TimerWheel::nowNs());
+            s.fires.fetch_add(1);
+        });
+        if (s.id == TimerWheel::INVALID_TIMER) {
+            std::fprintf(stderr, "timer pool exhausted\n");
+            return 1;
+        }
+    }
+
+    const bool throughputOk = throughput(wheel, slots, opt.ops);
+
+    const long long lateNs = static_cast<long long>(opt.late_ms) * 1'000'000;
+    std::uint64_t early = 0, late = 0, missing = 0, extra = 0, cancelledFired = 0;
+    long long worstEarly = 0, worstLate = 0;
+    unsigned seed = 12345;
+
+    for (int round = 0; round < opt.rounds; ++round) {
+        for (auto& s : slots) {
+            s.fired_at.store(-1);
+            s.fires.store(0);
+            seed = seed * 1664525u + 1013904223u;
+            s.plan = (seed >> 28) < 2 ? Plan::kCancel : (seed >> 28) < 5 ? Plan::kRearm : Plan::kFire;
+        }
+
+        // Arm from several threads; delays in fractional ms so deadlines fall inside ticks
+        constexpr int ARMERS = 4;
+        std::vector<std::thread> armers;
+        for (int t = 0; t < ARMERS; ++t) {
+            armers.emplace_back([&, t] {
+                unsigned r = 0xA5A5u + static_cast<unsigned>(t * 7919 + round * 104729);
+                for (std::size_t i = static_cast<std::size_t>(t); i < slots.size(); i += ARMERS) {
+                    r = r * 1664525u + 1013904223u;
+                    auto delay = static_cast<long long>(r % (static_cast<unsigned>(opt.max_ms) * 1000u)) * 1000;
+                    // Timers that get re-armed or cancelled at 5 ms must not be due before then
+                    if (slots[i].plan != Plan::kFire) delay = std::max(delay, 50'000'000LL);
+                    const long long due = TimerWheel::nowNs() + delay;
+                    slots[i].due.store(due);
+                    wheel.armAt(slots[i].id, due);
+                }
+            });
+        }
+        for (auto& th : armers) th.join();
+
+        // Re-arm (earlier or later) and cancel a share of them while the wheel runs
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        for (auto& s : slots) {
+            if (s.plan == Plan::kCancel) {
+                wheel.cancel(s.id);
+            } else if (s.plan == Plan::kRearm) {
+                seed = seed * 1664525u + 1013904223u;
+                const long long due =
+                    TimerWheel::nowNs() + static_cast<long long>(seed % 400'000u) * 1000 + 10'000'000;
+                s.due.store(due);
+                wheel.armAt(s.id, due);
+            }
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(opt.max_ms + opt.late_ms + 50));
+
+        for (const auto& s : slots) {
+            const auto fires = s.fires.load();
+            if (s.plan == Plan::kCancel) {
+                if (fires) ++cancelledFired;
+                continue;
+            }
+            if (fires == 0) {
+                ++missing;
+                continue;
+            }
+            if (fires > 1) ++extra;
+            const auto d = s.fired_at.load() - s.due.load();
+            if (d < 0) {
+                ++early;
+                worstEarly = std::max(worstEarly, -d);
+            } else if (d > lateNs) {
+                ++late;
+            }
+            worstLate = std::max(worstLate, d);
+        }
+        std::printf("round %d: timers=%d early=%llu late=%llu missing=%llu extra=%llu worst_early=%.3f ms "
+                    "worst_late=%.3f ms\n",
+                    round, opt.timers, static_cast<unsigned long long>(early), static_cast<unsigned long long>(late),
+                    static_cast<unsigned long long>(missing), static_cast<unsigned long long>(extra),
+                    static_cast<double>(worstEarly) / 1e6, static_cast<double>(worstLate) / 1e6);
+    }
+
+    // Teardown: shutdown() returns with the worker stopped, and nothing fires after it
+    wheel.shutdown();
+    wheel.shutdown();
+    static std::atomic<bool> s_after{false};
+    const auto after = wheel.create([] { s_after.store(true); });
+    wheel.arm(after, std::chrono::milliseconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const bool firedAfterShutdown = s_after.load();
+
+    const bool ok =
+        throughputOk && !early && !late && !missing && !extra && !cancelledFired && !firedAfterShutdown;
+    if (!ok) {
+        std::printf("FAILED (cancelled timers that fired: %llu, fired after shutdown: %d, throughput run: %s)\n",
+                    static_cast<unsigned long long>(cancelledFired), firedAfterShutdown ? 1 : 0,
+                    throughputOk ? "ok" : "timer fired or left armed");
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,177 @@
+// tracepoint_bench: what a tracepoint adds to each proxied EI callback, with tracing off, with the
+// deferred tracepoints (RMF_EI_TRACE), and with the inline debug line they replaced.
+//
+//   off      - the callback with RMF_EI_TRACE compiled out: forward to the original, nothing else
+//   deferred - EiTracepoints::emit into this thread's ring; the writer runs later, at drain()
+//   inline   - the old LOG_DEBUG: format the line, write it and flush (flush_on(debug)), per call
+//
+// Callbacks carry RaceMenu's ChangeWeight(arg0, weight, 2) on a stand-in for RE::GFxValue. They
+// come in bursts of --burst with a drain() between bursts, outside the timing, the way the timer
+// thread empties the rings between frames; the drain's own cost is reported per entry. The inline
+// row writes to a temporary file.
+//
+// Exits 1 when the writer does not see every call exactly once with its name and arguments, a
+// tracepoint is dropped, or a long name is not truncated to NAME_CHARS.
+//
+// usage: tracepoint_bench [--calls N] [--burst N]
+//   --calls <n>  callbacks per row (default 1000000)
+//   --burst <n>  callbacks between drains, at most the ring size (default 256)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+#include "core/ei_tracepoint.h"
+#include "core/timer_wheel.h"
+
+namespace {
+    namespace Trace = MorphFixer::EiTracepoints;
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int MAX_BURST = 1024;  // ei_tracepoint.cpp's ring
+
+    int g_failed = 0;
+
+    void check(bool ok, const char* what) {
+        if (ok) return;
+        if (++g_failed <= 20) std::printf("  CHECK FAILED: %s\n", what);
+    }
+
+    struct FakeValue {
+        [[nodiscard]] bool IsNumber() const { return number; }
+        [[nodiscard]] double GetNumber() const { return value; }
+
+        bool number{true};
+        double value{0.0};
+    };
+
+    // The writer: counts entries and checks them against what the callbacks sent
+    struct Seen {
+        std::uint64_t entries{0};
+        std::uint64_t bad{0};
+        std::uint64_t lost{0};
+        std::string lastName;
+    };
+    Seen g_seen;  // written under the drain lock, read after drain()
+
+    void countEntry(const Trace::Entry& e, long long) {
+        ++g_seen.entries;
+        const bool ok = e.argc == 3 && e.numeric == 0b111 && e.num[0] == 1.0 && e.num[2] == 2.0 &&
+                        e.num[1] >= 0.0 && e.num[1] < 1.0;
+        g_seen.bad += !ok;
+        g_seen.lastName.assign(e.name.data(), e.name_len);
+    }
+
+    void countLost(std::uint64_t n) { g_seen.lost += n; }
+
+    volatile double g_original = 0.0;  // what RaceMenu's handler does with the call
+
+    enum class Mode { kOff, kDeferred, kInline };
+
+    struct Row {
+        double callNs{0};
+        double drainNs{0};  // per entry
+    };
+
+    template <Mode M>
+    void callback(const char* name, const FakeValue* args, std::uint32_t argc, std::FILE* log) {
+        if constexpr (M == Mode::kDeferred) {
+            Trace::emit(name, args, argc);
+        } else if constexpr (M == Mode::kInline) {
+            char line[160];
+            const auto n = [&](std::uint32_t i) { return i < argc && args[i].IsNumber() ? args[i].GetNumber() : 0.0; };
+            const int len = std::snprintf(line, sizeof(line),
+                                          "[gfx-ei] %s(argc=%u) [0]=num:%.3f [1]=num:%.3f [2]=num:%.3f\n", name,
+                                          argc, n(0), n(1), n(2));
+            std::fwrite(line, 1, static_cast<std::size_t>(len), log);
+            std::fflush(log);
+        }
+        g_original = g_original + args[1].GetNumber();
+    }
+
+    template <Mode M>
+    Row run(long long calls, int burst, std::FILE* log) {
+        FakeValue args[3];
+        args[0].value = 1.0;
+        args[2].value = 2.0;
+
+        Row r;
+        double callNs = 0, drainNs = 0;
+        for (long long done = 0; done < calls;) {
+            const auto n = std::min<long long>(burst, calls - done);
+            const auto t0 = Clock::now();
+            for (long long i = 0; i < n; ++i) {
+                args[1].value = static_cast<double>((done + i) % 1000) / 1000.0;
+                callback<M>("ChangeWeight", args, 3, log);
+            }
+            const auto t1 = Clock::now();
+            Trace::drain();
+            callNs += std::chrono::duration<double, std::nano>(t1 - t0).count();
+            drainNs += std::chrono::duration<double, std::nano>(Clock::now() - t1).count();
+            done += n;
+        }
+        r.callNs = callNs / static_cast<double>(calls);
+        if (M == Mode::kDeferred) r.drainNs = drainNs / static_cast<double>(calls);
+        return r;
+    }
+
+    bool parseArgs(int argc, char** argv, long long& calls, int& burst) {
+        for (int i = 1; i + 1 < argc; i += 2) {
+            const std::string_view a = argv[i];
+            if (a == "--calls") {
+                calls = std::atoll(argv[i + 1]);
+            } else if (a == "--burst") {
+                burst = std::atoi(argv[i + 1]);
+            } else {
+                return false;
+            }
+        }
+        return argc % 2 == 1 && calls > 0 && burst > 0 && burst <= MAX_BURST;
+    }
+}
+
+int main(int argc, char** argv) {
+    long long calls = 1000000;
+    int burst = 256;
+    if (!parseArgs(argc, argv, calls, burst)) {
+        std::fprintf(stderr, "usage: %s [--calls N] [--burst 1..%d]\n", argv[0], MAX_BURST);
+        return 2;
+    }
+    std::FILE* log = std::tmpfile();
+    if (!log) {
+        std::fprintf(stderr, "no temporary file for the inline row\n");
+        return 2;
+    }
+    Trace::setWriter({countEntry, countLost});
+    std::printf("%lld callbacks per row, drained every %d\n", calls, burst);
+
+    const auto off = run<Mode::kOff>(calls, burst, log);
+    std::printf("off       %7.1f ns/callback\n", off.callNs);
+
+    const auto deferred = run<Mode::kDeferred>(calls, burst, log);
+    std::printf("deferred  %7.1f ns/callback  (+%.1f ns)  drain %.1f ns/entry (timer thread)\n",
+                deferred.callNs, deferred.callNs - off.callNs, deferred.drainNs);
+    check(g_seen.entries == static_cast<std::uint64_t>(calls), "writer saw every tracepoint once");
+    check(g_seen.bad == 0, "tracepoint arguments");
+    check(g_seen.lost == 0, "tracepoints dropped with bursts within the ring");
+    check(g_seen.lastName == "ChangeWeight", "tracepoint name");
+
+    const auto inl = run<Mode::kInline>(calls, burst, log);
+    std::printf("inline    %7.1f ns/callback  (+%.1f ns)\n", inl.callNs, inl.callNs - off.callNs);
+    std::fclose(log);
+
+    // Names past NAME_CHARS are cut, not overrun
+    const std::string longName(Trace::NAME_CHARS + 20, 'x');
+    FakeValue args[3]{{true, 1.0}, {true, 0.5}, {true, 2.0}};
+    Trace::emit(longName.c_str(), args, 3);
+    Trace::drain();
+    check(g_seen.lastName == longName.substr(0, Trace::NAME_CHARS), "long name truncated to NAME_CHARS");
+
+    MorphFixer::TimerWheel::get().shutdown();
+    if (g_failed) std::printf("FAILED (%d checks)\n", g_failed);
+    return g_failed ? 1 : 0;
+}